@@ -13,7 +13,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 8
-#define TINY_GSM_NO_MODEM_BUFFER
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -41,6 +40,8 @@
 #include "TinyGsmTime.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmA6, GSM_NO_MODEM_BUFFER, 1024, 0)
+
 enum A6RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -105,6 +106,7 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
 
     void stop(uint32_t maxWaitMs) {
       TINY_GSM_YIELD();
+      flushTx();
       at->sendAT(GF("+CIPCLOSE="), mux);
       sock_connected = false;
       at->waitResponse(maxWaitMs);
@@ -151,11 +153,11 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
     sendAT(
         GF("+CMER=3,0,0,2"));  // Set unsolicited result code output destination
@@ -329,7 +331,8 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
     if (waitResponse(5000L) != 1) { return false; }
 
     if (waitResponse(60000L, GF(AT_NL "+CIEV: \"CALL\",1"),
-                     GF(AT_NL "+CIEV: \"CALL\",0"), GFP(GSM_ERROR)) != 1) {
+                     GF(AT_NL "+CIEV: \"CALL\",0"),
+                     ModemTraits::error()) != 1) {
       return false;
     }
 
@@ -494,7 +497,9 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
     if (waitResponse(2000L, GF(AT_NL ">")) != 1) { return 0; }
     stream.write(reinterpret_cast<const uint8_t*>(buff), len);
     stream.flush();
-    if (waitResponse(10000L, GFP(GSM_OK), GF(AT_NL "FAIL")) != 1) { return 0; }
+    if (waitResponse(10000L, ModemTraits::ok(), GF(AT_NL "FAIL")) != 1) {
+      return 0;
+    }
     return len;
   }
 
@@ -509,38 +514,43 @@ class TinyGsmA6 : public TinyGsmModem<TinyGsmA6>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF("+CIPRCV:"))) {
-      int8_t  mux      = streamGetIntBefore(',');
-      int16_t len      = streamGetIntBefore(',');
-      int16_t len_orig = len;
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        if (len > sockets[mux]->rx.free()) {
-          DBG("### Buffer overflow: ", len, "->", sockets[mux]->rx.free());
-          // reset the len to read to the amount free
-          len = sockets[mux]->rx.free();
-        }
-        while (len--) { moveCharFromStreamToFifo(mux); }
-        // TODO(?) Deal with missing characters
-        if (len_orig != sockets[mux]->available()) {
-          DBG("### Different number of characters received than expected: ",
-              sockets[mux]->available(), " vs ", len_orig);
-        }
+ protected:
+  const TinyGsmUrcHandler<TinyGsmA6>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmA6> handlers[] = {
+        {GF("+CIPRCV:"), &TinyGsmA6::handleReceiveURC},
+        {GF("+TCPCLOSED:"), &TinyGsmA6::handleClosedURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux      = streamGetIntBefore(',');
+    int16_t len      = streamGetIntBefore(',');
+    int16_t len_orig = len;
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (len > 0 && static_cast<size_t>(len) > sockets[mux]->rxRoom()) {
+        DBG("### Buffer overflow: ", len, "->", sockets[mux]->rxRoom());
+        // reset the len to read to the amount free
+        len = sockets[mux]->rxRoom();
       }
-      data = "";
-      DBG("### Got Data: ", len_orig, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("+TCPCLOSED:"))) {
-      int8_t mux = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
+      len = moveStreamToClient(mux, len);
+      // TODO(?) Deal with missing characters
+      if (len_orig != len) {
+        DBG("### Different number of characters received than expected: ",
+            len, " vs ", len_orig);
       }
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
     }
-    return false;
+    DBG("### Got Data: ", len_orig, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
   }
 
  public:
@@ -12,7 +12,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 10
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -40,6 +39,8 @@
 #include "TinyGsmBattery.tpp"
 #include "TinyGsmTemperature.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmA7672X, GSM_BUFFER_READ_AND_CHECK_SIZE, 1500, 1500)
+
 enum A7672xRegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -199,11 +200,11 @@ class TinyGsmA7672X : public TinyGsmModem<TinyGsmA7672X>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("V1"));  // turn on verbose error codes
-#else
-    sendAT(GF("V0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -395,6 +396,8 @@ class TinyGsmA7672X : public TinyGsmModem<TinyGsmA7672X>,
     for (uint32_t start = millis(); millis() - start < timeout_ms;) {
       sendAT(GF("+CPIN?"));
       if (waitResponse(GF("+CPIN:")) != 1) {
+        SimStatus status;
+        if (simStatusFromError(status)) { return status; }
         delay(1000);
         continue;
       }
@@ -615,15 +618,7 @@ class TinyGsmA7672X : public TinyGsmModem<TinyGsmA7672X>,
       // this is actually be the number of bytes that will be remaining in the
       // buffer after the read.
     }
-    for (int i = 0; i < len_requested; i++) {
-      uint32_t startMillis = millis();
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
-      sockets[mux]->rx.put(c);
-    }
+    moveStreamToClient(mux, len_requested);
     // DBG("### READ:", len_requested, " bytes from connection ", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
     sockets[mux]->sock_available = len_confirmed;
@@ -675,92 +670,88 @@ class TinyGsmA7672X : public TinyGsmModem<TinyGsmA7672X>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+CIPRXGET:"))) {
-      int8_t mode = streamGetIntBefore(',');
-      if (mode == 1) {
-        int8_t mux = streamGetIntBefore('\n');
-        if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-          sockets[mux]->got_data = true;
-        }
-        data = "";
-        DBG("### Got Data:", mux);
-        return true;
-      } else {
-        data += mode;
-        return false;
-      }
-    } else if (data.endsWith(GF("RECV EVENT" AT_NL))) {
-      sendAT(GF("+CCHRECV?"));
-      String res = "";
-      waitResponse(2000L, res);
-      int8_t  mux = res.substring(res.lastIndexOf(',') + 1).toInt();
-      int16_t len =
-          res.substring(res.indexOf(',') + 1, res.lastIndexOf(',')).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->got_data = true;
-        if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-      }
-      data = "";
-      DBG("### Got Data:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("+CCHRECV: 0,0" AT_NL))) {
-      int8_t mux = data.substring(data.lastIndexOf(',') + 1).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = true;
-      }
-      data = "";
-      DBG("### ACK:", mux);
-      return true;
-    } else if (data.endsWith(GF("+IPCLOSE:"))) {
-      int8_t mux = streamGetIntBefore(',');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
-      }
-      data = "";
-      streamSkipUntil('\n');
-      DBG("### TCP Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("+CCHCLOSE:"))) {
-      int8_t mux = streamGetIntBefore(',');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
-      }
-      data = "";
-      streamSkipUntil('\n');
-      DBG("### SSL Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("+CCH_PEER_CLOSED:"))) {
+ protected:
+  const TinyGsmUrcHandler<TinyGsmA7672X>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmA7672X> handlers[] = {
+        {GF(AT_NL "+CIPRXGET:"), &TinyGsmA7672X::handleRxGetURC},
+        {GF("RECV EVENT" AT_NL), &TinyGsmA7672X::handleRecvEventURC},
+        {GF("+CCHRECV: 0,0" AT_NL), &TinyGsmA7672X::handleSslAckURC},
+        {GF("+IPCLOSE:"), &TinyGsmA7672X::handleClosedURC},
+        {GF("+CCHCLOSE:"), &TinyGsmA7672X::handleSslClosedURC},
+        {GF("+CCH_PEER_CLOSED:"), &TinyGsmA7672X::handleSslPeerClosedURC},
+        {GF("*PSNWID:"), &TinyGsmA7672X::handleIgnoredURC},
+        {GF("*PSUTTZ:"), &TinyGsmA7672X::handleIgnoredURC},
+        {GF("+CTZV:"), &TinyGsmA7672X::handleIgnoredURC},
+        {GF("DST:"), &TinyGsmA7672X::handleIgnoredURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleRxGetURC(GsmLineBuffer&) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode == 1) {
       int8_t mux = streamGetIntBefore('\n');
       if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
+        sockets[mux]->got_data = true;
       }
-      data = "";
-      DBG("### SSL Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("*PSNWID:"))) {
-      streamSkipUntil('\n');  // Refresh network name by network
-      data = "";
-      DBG("### Network name updated.");
-      return true;
-    } else if (data.endsWith(GF("*PSUTTZ:"))) {
-      streamSkipUntil('\n');  // Refresh time and time zone by network
-      data = "";
-      DBG("### Network time and time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("+CTZV:"))) {
-      streamSkipUntil('\n');  // Refresh network time zone by network
-      data = "";
-      DBG("### Network time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("DST:"))) {
-      streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
-      data = "";
-      DBG("### Daylight savings time state updated.");
+      DBG("### Got Data:", mux);
       return true;
+    } else {
+      return false;
+    }
+  }
+
+  bool handleRecvEventURC(GsmLineBuffer&) {
+    sendAT(GF("+CCHRECV?"));
+    String res = "";
+    waitResponse(2000L, res);
+    int8_t  mux = res.substring(res.lastIndexOf(',') + 1).toInt();
+    int16_t len =
+        res.substring(res.indexOf(',') + 1, res.lastIndexOf(',')).toInt();
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool handleSslAckURC(GsmLineBuffer& data) {
+    int8_t mux = atoi(data.c_str() + data.lastIndexOf(',', data.length()) + 1);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = true;
     }
-    return false;
+    DBG("### ACK:", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore(',');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    streamSkipUntil('\n');
+    DBG("### TCP Closed: ", mux);
+    return true;
+  }
+
+  bool handleSslClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore(',');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    streamSkipUntil('\n');
+    DBG("### SSL Closed: ", mux);
+    return true;
+  }
+
+  bool handleSslPeerClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### SSL Closed: ", mux);
+    return true;
   }
 
  public:
@@ -13,7 +13,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 12
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -45,6 +44,8 @@
 #include "TinyGsmBattery.tpp"
 #include "TinyGsmTemperature.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmBG96, GSM_BUFFER_READ_AND_CHECK_SIZE, 1460, 1500)
+
 enum BG96RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -190,11 +191,11 @@ class TinyGsmBG96 : public TinyGsmModem<TinyGsmBG96>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -706,6 +707,9 @@ class TinyGsmBG96 : public TinyGsmModem<TinyGsmBG96>,
   }
 
   int16_t modemSend(const void* buff, size_t len, uint8_t mux) {
+#if defined TINY_GSM_SEND_WINDOW
+    if (!waitSendWindow(mux, len)) { return 0; }
+#endif
     bool ssl = sockets[mux]->ssl_sock;
     if (ssl) {
       sendAT(GF("+QSSLSEND="), mux, ',', (uint16_t)len);
@@ -715,7 +719,12 @@ class TinyGsmBG96 : public TinyGsmModem<TinyGsmBG96>,
     if (waitResponse(GF(">")) != 1) { return 0; }
     stream.write(reinterpret_cast<const uint8_t*>(buff), len);
     stream.flush();
+#if defined TINY_GSM_SEND_WINDOW
+    // handleSendResultURC picks up the SEND OK or SEND FAIL
+    sendPending(mux, len);
+#else
     if (waitResponse(GF(AT_NL "SEND OK")) != 1) { return 0; }
+#endif
     // TODO(?): Wait for ACK? (AT+QISEND=id,0 or AT+QSSLSEND=id,0)
     return len;
   }
@@ -735,14 +744,14 @@ class TinyGsmBG96 : public TinyGsmModem<TinyGsmBG96>,
     }
     int16_t len = streamGetIntBefore('\n');
 
-    for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+    moveStreamToClient(mux, len);
     waitResponse();
     // DBG("### READ:", len, "from", mux);
-    sockets[mux]->sock_available = modemGetAvailable(mux);
+    accountRead(mux, size, len);
     return len;
   }
 
-  size_t modemGetAvailable(uint8_t mux) {
+  size_t modemGetAvailable(uint8_t mux, bool check_connected = true) {
     if (!sockets[mux]) return 0;
     bool   ssl    = sockets[mux]->ssl_sock;
     size_t result = 0;
@@ -765,10 +774,67 @@ class TinyGsmBG96 : public TinyGsmModem<TinyGsmBG96>,
         waitResponse();
       }
     }
-    if (!result) { sockets[mux]->sock_connected = modemGetConnected(mux); }
+    if (!result && check_connected) {
+      sockets[mux]->sock_connected = modemGetConnected(mux);
+    }
     return result;
   }
 
+  void modemRefreshSockets() {
+    bool check_tcp = false;
+    bool check_ssl = false;
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientBG96* sock = sockets[mux];
+      if (!sock || !sock->got_data) continue;
+      sock->got_data = false;
+      // AT+QIRD and AT+QSSLRECV only take one socket at a time, so the amount
+      // waiting has to be asked for per socket
+      sock->sock_available = modemGetAvailable(mux, false);
+      if (sock->sock_available) continue;
+      if (sock->ssl_sock) {
+        check_ssl = true;
+      } else {
+        check_tcp = true;
+      }
+    }
+    // A single AT+QISTATE or AT+QSSLSTATE covers every socket of its kind
+    if (check_tcp) { modemGetAllConnected(false); }
+    if (check_ssl) { modemGetAllConnected(true); }
+  }
+
+  void modemGetAllConnected(bool ssl) {
+    bool connected[TINY_GSM_MUX_COUNT] = {};
+    if (ssl) {
+      sendAT(GF("+QSSLSTATE"));
+    } else {
+      sendAT(GF("+QISTATE"));
+    }
+    // +QISTATE: 0,"TCP","151.139.237.11",80,5087,4,1,0,0,"uart1"
+    // +QSSLSTATE: 0,"SSLClient","151.139.237.11",443,5087,4,1,0,0,"uart1",1
+    // for each open connection, then OK
+    int8_t res;
+    while ((res = waitResponse(ssl ? GF("+QSSLSTATE:") : GF("+QISTATE:"),
+                               GFP(GSM_OK), GFP(GSM_ERROR))) == 1) {
+      int8_t mux = streamGetIntBefore(',');
+      streamSkipUntil(',');                    // Skip socket type
+      streamSkipUntil(',');                    // Skip remote ip
+      streamSkipUntil(',');                    // Skip remote port
+      streamSkipUntil(',');                    // Skip local port
+      int8_t state = streamGetIntBefore(',');  // socket state
+      streamSkipUntil('\n');
+      // 0 Initial, 1 Opening, 2 Connected, 3 Listening, 4 Closing
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT) { connected[mux] = 2 == state; }
+    }
+    // Only a complete list says which sockets are gone
+    if (res != 2) { return; }
+    for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
+      GsmClientBG96* sock = sockets[mux];
+      if (sock && sock->ssl_sock == ssl) {
+        sock->sock_connected = connected[mux];
+      }
+    }
+  }
+
   bool modemGetConnected(uint8_t mux) {
     bool ssl = sockets[mux]->ssl_sock;
     if (ssl) {
@@ -811,33 +877,49 @@ class TinyGsmBG96 : public TinyGsmModem<TinyGsmBG96>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+QIURC:"))) {
-      streamSkipUntil('\"');
-      String urc = stream.readStringUntil('\"');
-      streamSkipUntil(',');
-      if (urc == "recv") {
-        int8_t mux = streamGetIntBefore('\n');
-        DBG("### URC RECV:", mux);
-        if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-          sockets[mux]->got_data = true;
-        }
-      } else if (urc == "closed") {
-        int8_t mux = streamGetIntBefore('\n');
-        DBG("### URC CLOSE:", mux);
-        if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-          sockets[mux]->sock_connected = false;
-        }
-      } else {
-        streamSkipUntil('\n');
+ protected:
+  const TinyGsmUrcHandler<TinyGsmBG96>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmBG96> handlers[] = {
+        {GF(AT_NL "+QIURC:"), &TinyGsmBG96::handleSocketURC},
+#if defined TINY_GSM_SEND_WINDOW
+        {GF(AT_NL "SEND OK"), &TinyGsmBG96::handleSendResultURC},
+        {GF(AT_NL "SEND FAIL"), &TinyGsmBG96::handleSendResultURC},
+#endif
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleSocketURC(GsmLineBuffer&) {
+    streamSkipUntil('\"');
+    char   urc[16];
+    size_t urc_len = stream.readBytesUntil('\"', urc, sizeof(urc) - 1);
+    urc[urc_len]   = '\0';
+    streamSkipUntil(',');
+    if (strcmp(urc, "recv") == 0) {
+      int8_t mux = streamGetIntBefore('\n');
+      DBG("### URC RECV:", mux);
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->got_data = true;
       }
-      data = "";
-      return true;
+    } else if (strcmp(urc, "closed") == 0) {
+      int8_t mux = streamGetIntBefore('\n');
+      DBG("### URC CLOSE:", mux);
+      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+        sockets[mux]->sock_connected = false;
+      }
+    } else {
+      streamSkipUntil('\n');
     }
-    return false;
+    return true;
   }
 
+#if defined TINY_GSM_SEND_WINDOW
+  bool handleSendResultURC(GsmLineBuffer& data) {
+    sendAcked(data.endsWith(GF("OK")));
+    return true;
+  }
+#endif
+
  public:
   Stream& stream;
 
@@ -13,7 +13,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 5
-#define TINY_GSM_NO_MODEM_BUFFER
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -38,6 +37,8 @@
 #include "TinyGsmSSL.tpp"
 #include "TinyGsmWifi.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmESP8266, GSM_NO_MODEM_BUFFER, 2048, 0)
+
 static uint8_t TINY_GSM_TCP_KEEP_ALIVE = 120;
 
 // <stat> status of ESP8266 station interface
@@ -106,6 +107,7 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
 
     void stop(uint32_t maxWaitMs) {
       TINY_GSM_YIELD();
+      flushTx();
       at->sendAT(GF("+CIPCLOSE="), mux);
       sock_connected = false;
       at->waitResponse(maxWaitMs);
@@ -353,9 +355,11 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     // attempt first without than with the 'current' flag used in some firmware
     // versions
     sendAT(GF("+CWJAP=\""), ssid, GF("\",\""), pwd, GF("\""));
-    if (waitResponse(30000L, GFP(GSM_OK), GF(AT_NL "FAIL" AT_NL)) != 1) {
+    if (waitResponse(30000L, ModemTraits::ok(), GF(AT_NL "FAIL" AT_NL)) !=
+        1) {
       sendAT(GF("+CWJAP_CUR=\""), ssid, GF("\",\""), pwd, GF("\""));
-      if (waitResponse(30000L, GFP(GSM_OK), GF(AT_NL "FAIL" AT_NL)) != 1) {
+      if (waitResponse(30000L, ModemTraits::ok(),
+                       GF(AT_NL "FAIL" AT_NL)) != 1) {
         return false;
       }
     }
@@ -441,8 +445,8 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
            GF("\",\""), host, GF("\","), port, GF(","),
            TINY_GSM_TCP_KEEP_ALIVE);
     // TODO(?): Check mux
-    int8_t rsp = waitResponse(timeout_ms, GFP(GSM_OK), GFP(GSM_ERROR),
-                              GF("ALREADY CONNECT"));
+    int8_t rsp = waitResponse(timeout_ms, ModemTraits::ok(),
+                              ModemTraits::error(), GF("ALREADY CONNECT"));
     // if (rsp == 3) waitResponse();
     // May return "ERROR" after the "ALREADY CONNECT"
     return (1 == rsp);
@@ -463,7 +467,8 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     // after "STATUS:" it should return the status number (0,1,2,3,4,5),
     // followed by an OK
     // Hopefully we'll catch the "3" here, but fall back to the OK or Error
-    int8_t status = waitResponse(GF("3"), GFP(GSM_OK), GFP(GSM_ERROR));
+    int8_t status = waitResponse(GF("3"), ModemTraits::ok(),
+                                 ModemTraits::error());
     // if the status is anything but 3, there are no connections open
     if (status != 1) {
       for (int muxNo = 0; muxNo < TINY_GSM_MUX_COUNT; muxNo++) {
@@ -473,8 +478,8 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
     }
     bool verified_connections[TINY_GSM_MUX_COUNT] = {0, 0, 0, 0, 0};
     for (int muxNo = 0; muxNo < TINY_GSM_MUX_COUNT; muxNo++) {
-      uint8_t has_status = waitResponse(GF("+CIPSTATUS:"), GFP(GSM_OK),
-                                        GFP(GSM_ERROR));
+      uint8_t has_status = waitResponse(GF("+CIPSTATUS:"), ModemTraits::ok(),
+                                        ModemTraits::error());
       if (has_status == 1) {
         int8_t returned_mux = streamGetIntBefore(',');
         streamSkipUntil(',');   // Skip mux
@@ -498,42 +503,45 @@ class TinyGsmESP8266 : public TinyGsmModem<TinyGsmESP8266>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF("+IPD,"))) {
-      int8_t  mux      = streamGetIntBefore(',');
-      int16_t len      = streamGetIntBefore(':');
-      int16_t len_orig = len;
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        if (len > sockets[mux]->rx.free()) {
-          DBG("### Buffer overflow: ", len, "->", sockets[mux]->rx.free());
-          // reset the len to read to the amount free
-          len = sockets[mux]->rx.free();
-        }
-        while (len--) { moveCharFromStreamToFifo(mux); }
-        // TODO(SRGDamia1): deal with buffer overflow/missed characters
-        if (len_orig != sockets[mux]->available()) {
-          DBG("### Different number of characters received than expected: ",
-              sockets[mux]->available(), " vs ", len_orig);
-        }
+ protected:
+  const TinyGsmUrcHandler<TinyGsmESP8266>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmESP8266> handlers[] = {
+        {GF("+IPD,"), &TinyGsmESP8266::handleReceiveURC},
+        {GF("CLOSED"), &TinyGsmESP8266::handleClosedURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux      = streamGetIntBefore(',');
+    int16_t len      = streamGetIntBefore(':');
+    int16_t len_orig = len;
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (len > 0 && static_cast<size_t>(len) > sockets[mux]->rxRoom()) {
+        DBG("### Buffer overflow: ", len, "->", sockets[mux]->rxRoom());
+        // reset the len to read to the amount free
+        len = sockets[mux]->rxRoom();
       }
-      data = "";
-      DBG("### Got Data: ", len_orig, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("CLOSED"))) {
-      int8_t muxStart = TinyGsmMax(0,
-                                   data.lastIndexOf(AT_NL, data.length() - 8));
-      int8_t coma     = data.indexOf(',', muxStart);
-      int8_t mux      = data.substring(muxStart, coma).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
+      len = moveStreamToClient(mux, len);
+      // TODO(SRGDamia1): deal with buffer overflow/missed characters
+      if (len_orig != len) {
+        DBG("### Different number of characters received than expected: ",
+            len, " vs ", len_orig);
       }
-      streamSkipUntil('\n');  // throw away the new line
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
     }
-    return false;
+    DBG("### Got Data: ", len_orig, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer& data) {
+    int16_t nl  = data.lastIndexOf('\n', data.length() - 6);
+    int8_t  mux = atoi(data.c_str() + nl + 1);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    streamSkipUntil('\n');  // throw away the new line
+    DBG("### Closed: ", mux);
+    return true;
   }
 
  public:
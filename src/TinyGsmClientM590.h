@@ -13,7 +13,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 2
-#define TINY_GSM_NO_MODEM_BUFFER
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -35,6 +34,8 @@
 #include "TinyGsmSMS.tpp"
 #include "TinyGsmTime.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmM590, GSM_NO_MODEM_BUFFER, 1024, 0)
+
 enum M590RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -96,6 +97,7 @@ class TinyGsmM590 : public TinyGsmModem<TinyGsmM590>,
 
     void stop(uint32_t maxWaitMs) {
       TINY_GSM_YIELD();
+      flushTx();
       at->sendAT(GF("+TCPCLOSE="), mux);
       sock_connected = false;
       at->waitResponse(maxWaitMs);
@@ -138,11 +140,11 @@ class TinyGsmM590 : public TinyGsmModem<TinyGsmM590>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -459,39 +461,44 @@ class TinyGsmM590 : public TinyGsmModem<TinyGsmM590>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF("+TCPRECV:"))) {
-      int8_t  mux      = streamGetIntBefore(',');
-      int16_t len      = streamGetIntBefore(',');
-      int16_t len_orig = len;
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        if (len > sockets[mux]->rx.free()) {
-          DBG("### Buffer overflow: ", len, "->", sockets[mux]->rx.free());
-          // reset the len to read to the amount free
-          len = sockets[mux]->rx.free();
-        }
-        while (len--) { moveCharFromStreamToFifo(mux); }
-        // TODO(?): Handle lost characters
-        if (len_orig != sockets[mux]->available()) {
-          DBG("### Different number of characters received than expected: ",
-              sockets[mux]->available(), " vs ", len_orig);
-        }
+ protected:
+  const TinyGsmUrcHandler<TinyGsmM590>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmM590> handlers[] = {
+        {GF("+TCPRECV:"), &TinyGsmM590::handleReceiveURC},
+        {GF("+TCPCLOSE:"), &TinyGsmM590::handleClosedURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux      = streamGetIntBefore(',');
+    int16_t len      = streamGetIntBefore(',');
+    int16_t len_orig = len;
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (len > 0 && static_cast<size_t>(len) > sockets[mux]->rxRoom()) {
+        DBG("### Buffer overflow: ", len, "->", sockets[mux]->rxRoom());
+        // reset the len to read to the amount free
+        len = sockets[mux]->rxRoom();
       }
-      data = "";
-      DBG("### Got Data: ", len_orig, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("+TCPCLOSE:"))) {
-      int8_t mux = streamGetIntBefore(',');
-      streamSkipUntil('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
+      len = moveStreamToClient(mux, len);
+      // TODO(?): Handle lost characters
+      if (len_orig != len) {
+        DBG("### Different number of characters received than expected: ",
+            len, " vs ", len_orig);
       }
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
     }
-    return false;
+    DBG("### Got Data: ", len_orig, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore(',');
+    streamSkipUntil('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
   }
 
  public:
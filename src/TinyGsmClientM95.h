@@ -14,7 +14,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 6
-#define TINY_GSM_BUFFER_READ_NO_CHECK
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -39,6 +38,8 @@
 #include "TinyGsmBattery.tpp"
 #include "TinyGsmTemperature.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmM95, GSM_BUFFER_READ_NO_CHECK, 1460, 1500)
+
 enum M95RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -153,11 +154,11 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -494,7 +495,8 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
     sendAT(GF("+QIRD=0,1,"), mux, ',', (uint16_t)size);
     // If it replies only OK for the write command, it means there is no
     // received data in the buffer of the connection.
-    int8_t res = waitResponse(GF("+QIRD:"), GFP(GSM_OK), GFP(GSM_ERROR));
+    int8_t res = waitResponse(GF("+QIRD:"), ModemTraits::ok(),
+                              ModemTraits::error());
     if (res == 1) {
       streamSkipUntil(':');  // skip IP address
       streamSkipUntil(',');  // skip port
@@ -507,12 +509,9 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
       // that much there. In that case, make sure we make sure we re-set the
       // amount of data available.
       if (len < size) { sockets[mux]->sock_available = len; }
-      for (uint16_t i = 0; i < len; i++) {
-        moveCharFromStreamToFifo(mux);
-        sockets[mux]->sock_available--;
-        // ^^ One less character available after moving from modem's FIFO to our
-        // FIFO
-      }
+      sockets[mux]->sock_available -= moveStreamToClient(mux, len);
+      // ^^ That many fewer characters available after moving them out of the
+      // modem's FIFO
       waitResponse();  // ends with an OK
       // DBG("### READ:", len, "from", mux);
       return len;
@@ -549,37 +548,37 @@ class TinyGsmM95 : public TinyGsmModem<TinyGsmM95>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+QIRDI:"))) {
-      streamSkipUntil(',');  // Skip the context
-      streamSkipUntil(',');  // Skip the role
-      int8_t mux = streamGetIntBefore('\n');
-      // DBG("### Got Data:", mux);
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        // We have no way of knowing how much data actually came in, so
-        // we set the value to 1500, the maximum possible size.
-        sockets[mux]->sock_available = 1500;
-      }
-      data = "";
-      return true;
-    } else if (data.endsWith(GF("CLOSED" AT_NL))) {
-      int8_t nl   = data.lastIndexOf(AT_NL, data.length() - 8);
-      int8_t coma = data.indexOf(',', nl + 2);
-      int8_t mux  = data.substring(nl + 2, coma).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
-      }
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("+QNITZ:"))) {
-      streamSkipUntil('\n');  // URC for time sync
-      data = "";
-      DBG("### Network time updated.");
-      return true;
+ protected:
+  const TinyGsmUrcHandler<TinyGsmM95>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmM95> handlers[] = {
+        {GF(AT_NL "+QIRDI:"), &TinyGsmM95::handleReceiveURC},
+        {GF("CLOSED" AT_NL), &TinyGsmM95::handleClosedURC},
+        {GF("+QNITZ:"), &TinyGsmM95::handleIgnoredURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    streamSkipUntil(',');  // Skip the context
+    streamSkipUntil(',');  // Skip the role
+    int8_t mux = streamGetIntBefore('\n');
+    // DBG("### Got Data:", mux);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      // We have no way of knowing how much data actually came in, so
+      // we set the value to 1500, the maximum possible size.
+      sockets[mux]->sock_available = 1500;
     }
-    return false;
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer& data) {
+    int16_t nl  = data.lastIndexOf('\n', data.length() - 8);
+    int8_t  mux = atoi(data.c_str() + nl + 1);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
   }
 
  public:
@@ -16,7 +16,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 6
-#define TINY_GSM_BUFFER_READ_NO_CHECK
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -44,6 +43,8 @@
 #include "TinyGsmTime.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmMC60, GSM_BUFFER_READ_NO_CHECK, 1460, 1500)
+
 enum MC60RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -156,11 +157,11 @@ class TinyGsmMC60 : public TinyGsmModem<TinyGsmMC60>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -324,6 +325,8 @@ class TinyGsmMC60 : public TinyGsmModem<TinyGsmMC60>,
     for (uint32_t start = millis(); millis() - start < timeout_ms;) {
       sendAT(GF("+CPIN?"));
       if (waitResponse(GF(AT_NL "+CPIN:")) != 1) {
+        SimStatus status;
+        if (simStatusFromError(status)) { return status; }
         delay(1000);
         continue;
       }
@@ -477,7 +480,8 @@ class TinyGsmMC60 : public TinyGsmModem<TinyGsmMC60>,
     sendAT(GF("+QIRD=0,1,"), mux, ',', (uint16_t)size);
     // If it replies only OK for the write command, it means there is no
     // received data in the buffer of the connection.
-    int8_t res = waitResponse(GF("+QIRD:"), GFP(GSM_OK), GFP(GSM_ERROR));
+    int8_t res = waitResponse(GF("+QIRD:"), ModemTraits::ok(),
+                              ModemTraits::error());
     if (res == 1) {
       streamSkipUntil(':');  // skip IP address
       streamSkipUntil(',');  // skip port
@@ -489,12 +493,9 @@ class TinyGsmMC60 : public TinyGsmModem<TinyGsmMC60>,
       // be different sizes.
       // If so, make sure we make sure we re-set the amount of data available.
       if (len < size) { sockets[mux]->sock_available = len; }
-      for (uint16_t i = 0; i < len; i++) {
-        moveCharFromStreamToFifo(mux);
-        sockets[mux]->sock_available--;
-        // ^^ One less character available after moving from modem's FIFO to our
-        // FIFO
-      }
+      sockets[mux]->sock_available -= moveStreamToClient(mux, len);
+      // ^^ That many fewer characters available after moving them out of the
+      // modem's FIFO
       waitResponse();  // ends with an OK
       // DBG("### READ:", len, "from", mux);
       return len;
@@ -531,44 +532,45 @@ class TinyGsmMC60 : public TinyGsmModem<TinyGsmMC60>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+QIRDI:"))) {  // TODO(?):  QIRD? or QIRDI?
-      // +QIRDI: <id>,<sc>,<sid>,<num>,<len>,< tlen>
-      streamSkipUntil(',');  // Skip the context
-      streamSkipUntil(',');  // Skip the role
-      // read the connection id
-      int8_t mux = streamGetIntBefore(',');
-      // read the number of packets in the buffer
-      int8_t num_packets = streamGetIntBefore(',');
-      // read the length of the current packet
-      streamSkipUntil(
-          ',');  // Skip the length of the current package in the buffer
-      int16_t len_total =
-          streamGetIntBefore('\n');  // Total length of all packages
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
-          num_packets >= 0 && len_total >= 0) {
-        sockets[mux]->sock_available = len_total;
-      }
-      data = "";
-      // DBG("### Got Data:", len_total, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("CLOSED" AT_NL))) {
-      int8_t nl   = data.lastIndexOf(AT_NL, data.length() - 8);
-      int8_t coma = data.indexOf(',', nl + 2);
-      int8_t mux  = data.substring(nl + 2, coma).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
-      }
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("+QNITZ:"))) {
-      streamSkipUntil('\n');  // URC for time sync
-      DBG("### Network time updated.");
-      data = "";
+ protected:
+  const TinyGsmUrcHandler<TinyGsmMC60>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmMC60> handlers[] = {
+        {GF(AT_NL "+QIRDI:"), &TinyGsmMC60::handleReceiveURC},
+        {GF("CLOSED" AT_NL), &TinyGsmMC60::handleClosedURC},
+        {GF("+QNITZ:"), &TinyGsmMC60::handleIgnoredURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {  // TODO(?):  QIRD? or QIRDI?
+    // +QIRDI: <id>,<sc>,<sid>,<num>,<len>,< tlen>
+    streamSkipUntil(',');  // Skip the context
+    streamSkipUntil(',');  // Skip the role
+    // read the connection id
+    int8_t mux = streamGetIntBefore(',');
+    // read the number of packets in the buffer
+    int8_t num_packets = streamGetIntBefore(',');
+    // read the length of the current packet
+    streamSkipUntil(
+        ',');  // Skip the length of the current package in the buffer
+    int16_t len_total =
+        streamGetIntBefore('\n');  // Total length of all packages
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
+        num_packets >= 0 && len_total >= 0) {
+      sockets[mux]->sock_available = len_total;
     }
-    return false;
+    // DBG("### Got Data:", len_total, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer& data) {
+    int16_t nl  = data.lastIndexOf('\n', data.length() - 8);
+    int8_t  mux = atoi(data.c_str() + nl + 1);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
   }
 
  public:
@@ -13,7 +13,6 @@
 // #define TINY_GSM_USE_HEX
 
 #define TINY_GSM_MUX_COUNT 8
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 
 #include "TinyGsmClientSIM70xx.h"
 #include "TinyGsmTCP.tpp"
@@ -23,6 +22,9 @@
 #include "TinyGsmNTP.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmSim7000, GSM_BUFFER_READ_AND_CHECK_SIZE, 1460,
+                      1460)
+
 class TinyGsmSim7000 : public TinyGsmSim70xx<TinyGsmSim7000>,
                        public TinyGsmTCP<TinyGsmSim7000, TINY_GSM_MUX_COUNT>,
                        public TinyGsmSMS<TinyGsmSim7000>,
@@ -126,11 +128,11 @@ class TinyGsmSim7000 : public TinyGsmSim70xx<TinyGsmSim7000>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -378,9 +380,9 @@ class TinyGsmSim7000 : public TinyGsmSim70xx<TinyGsmSim7000>,
     // SRGD NOTE:  Contrary to above (which is copied from AT command manual)
     // this is actually be the number of bytes that will be remaining in the
     // buffer after the read.
+#ifdef TINY_GSM_USE_HEX
     for (int i = 0; i < len_requested; i++) {
       uint32_t startMillis = millis();
-#ifdef TINY_GSM_USE_HEX
       while (stream.available() < 2 &&
              (millis() - startMillis < sockets[mux]->_timeout)) {
         TINY_GSM_YIELD();
@@ -391,15 +393,11 @@ class TinyGsmSim7000 : public TinyGsmSim70xx<TinyGsmSim7000>,
       buf[0] = stream.read();
       buf[1] = stream.read();
       char c = strtol(buf, nullptr, 16);
+      putCharToClient(mux, c);
+    }
 #else
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
+    moveStreamToClient(mux, len_requested);
 #endif
-      sockets[mux]->rx.put(c);
-    }
     // DBG("### READ:", len_requested, "from", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
     sockets[mux]->sock_available = len_confirmed;
@@ -436,69 +434,60 @@ class TinyGsmSim7000 : public TinyGsmSim70xx<TinyGsmSim7000>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+CIPRXGET:"))) {
-      int8_t mode = streamGetIntBefore(',');
-      if (mode == 1) {
-        int8_t mux = streamGetIntBefore('\n');
-        if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-          sockets[mux]->got_data = true;
-        }
-        data = "";
-        // DBG("### Got Data:", mux);
-        return true;
-      } else {
-        data += mode;
-        return false;
-      }
-    } else if (data.endsWith(GF(AT_NL "+RECEIVE:"))) {
-      int8_t  mux = streamGetIntBefore(',');
-      int16_t len = streamGetIntBefore('\n');
+ protected:
+  const TinyGsmUrcHandler<TinyGsmSim7000>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmSim7000> handlers[] = {
+        {GF(AT_NL "+CIPRXGET:"), &TinyGsmSim7000::handleRxGetURC},
+        {GF(AT_NL "+RECEIVE:"), &TinyGsmSim7000::handleReceiveURC},
+        {GF("CLOSED" AT_NL), &TinyGsmSim7000::handleClosedURC},
+        {GF("*PSNWID:"), &TinyGsmSim7000::handleIgnoredURC},
+        {GF("*PSUTTZ:"), &TinyGsmSim7000::handleIgnoredURC},
+        {GF("+CTZV:"), &TinyGsmSim7000::handleIgnoredURC},
+        {GF("DST: "), &TinyGsmSim7000::handleIgnoredURC},
+        {GF(AT_NL "SMS Ready" AT_NL), &TinyGsmSim7000::handleModemResetURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleRxGetURC(GsmLineBuffer&) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode == 1) {
+      int8_t mux = streamGetIntBefore('\n');
       if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
         sockets[mux]->got_data = true;
-        if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-      }
-      data = "";
-      // DBG("### Got Data:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("CLOSED" AT_NL))) {
-      int8_t nl   = data.lastIndexOf(AT_NL, data.length() - 8);
-      int8_t coma = data.indexOf(',', nl + 2);
-      int8_t mux  = data.substring(nl + 2, coma).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
       }
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("*PSNWID:"))) {
-      streamSkipUntil('\n');  // Refresh network name by network
-      data = "";
-      DBG("### Network name updated.");
-      return true;
-    } else if (data.endsWith(GF("*PSUTTZ:"))) {
-      streamSkipUntil('\n');  // Refresh time and time zone by network
-      data = "";
-      DBG("### Network time and time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("+CTZV:"))) {
-      streamSkipUntil('\n');  // Refresh network time zone by network
-      data = "";
-      DBG("### Network time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("DST: "))) {
-      streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
-      data = "";
-      DBG("### Daylight savings time state updated.");
-      return true;
-    } else if (data.endsWith(GF(AT_NL "SMS Ready" AT_NL))) {
-      data = "";
-      DBG("### Unexpected module reset!");
-      init();
+      // DBG("### Got Data:", mux);
       return true;
+    } else {
+      return false;
+    }
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    // DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer& data) {
+    int16_t nl  = data.lastIndexOf('\n', data.length() - 8);
+    int8_t  mux = atoi(data.c_str() + nl + 1);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
     }
-    return false;
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+  bool handleModemResetURC(GsmLineBuffer&) {
+    DBG("### Unexpected module reset!");
+    init();
+    return true;
   }
 
  protected:
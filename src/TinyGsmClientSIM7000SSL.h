@@ -13,7 +13,6 @@
 // #define TINY_GSM_USE_HEX
 
 #define TINY_GSM_MUX_COUNT 2
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 
 #include "TinyGsmClientSIM70xx.h"
 #include "TinyGsmTCP.tpp"
@@ -24,6 +23,9 @@
 #include "TinyGsmNTP.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmSim7000SSL, GSM_BUFFER_READ_AND_CHECK_SIZE, 1460,
+                      1460)
+
 class TinyGsmSim7000SSL
     : public TinyGsmSim70xx<TinyGsmSim7000SSL>,
       public TinyGsmTCP<TinyGsmSim7000SSL, TINY_GSM_MUX_COUNT>,
@@ -152,11 +154,11 @@ class TinyGsmSim7000SSL
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -181,9 +183,7 @@ class TinyGsmSim7000SSL
     }
   }
 
-  void maintainImpl() {
-    // Keep listening for modem URC's and proactively iterate through
-    // sockets asking if any data is avaiable
+  void modemRefreshSockets() {
     bool check_socks = false;
     for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
       GsmClientSim7000SSL* sock = sockets[mux];
@@ -193,9 +193,8 @@ class TinyGsmSim7000SSL
       }
     }
     // modemGetAvailable checks all socks, so we only want to do it once
-    // modemGetAvailable calls modemGetConnected(), which also checks allf
+    // modemGetAvailable calls modemGetConnected(), which also checks all
     if (check_socks) { modemGetAvailable(0); }
-    while (stream.available()) { waitResponse(15, nullptr, nullptr); }
   }
 
   /*
@@ -282,6 +281,8 @@ class TinyGsmSim7000SSL
       sendAT(GF("+CNACT=1,\""), apn, GF("\""));
       res = waitResponse(60000L, GF(AT_NL "+APP PDP: ACTIVE"),
                          GF(AT_NL "+APP PDP: DEACTIVE")) == 1;
+      // Don't retry if the modem refused outright
+      if (lastError() >= 0) { break; }
       waitResponse();
       ntries++;
     }
@@ -511,21 +512,13 @@ class TinyGsmSim7000SSL
       return 0;
     }
 
-    for (int i = 0; i < len_confirmed; i++) {
-      uint32_t startMillis = millis();
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
-      sockets[mux]->rx.put(c);
-    }
+    moveStreamToClient(mux, len_confirmed);
     waitResponse();
     // DBG("### READ:", len_confirmed, "from", mux);
-    // make sure the sock available number is accurate again
     // the module is **EXTREMELY** testy about being asked to read more from
     // the buffer than exits; it will freeze until a hard reset or power cycle!
-    sockets[mux]->sock_available = modemGetAvailable(mux);
+    // The count accountRead keeps never runs ahead of what the module holds.
+    accountRead(mux, size, len_confirmed);
     return len_confirmed;
   }
 
@@ -632,64 +625,57 @@ class TinyGsmSim7000SSL
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF("+CARECV:"))) {
-      int8_t  mux = streamGetIntBefore(',');
-      int16_t len = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->got_data = true;
-        if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-      }
-      data = "";
-      DBG("### Got Data:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("+CADATAIND:"))) {
-      int8_t mux = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->got_data = true;
-      }
-      data = "";
-      DBG("### Got Data:", mux);
-      return true;
-    } else if (data.endsWith(GF("+CASTATE:"))) {
-      int8_t mux   = streamGetIntBefore(',');
-      int8_t state = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        if (state != 1) {
-          sockets[mux]->sock_connected = false;
-          DBG("### Closed: ", mux);
-        }
+ protected:
+  const TinyGsmUrcHandler<TinyGsmSim7000SSL>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmSim7000SSL> handlers[] = {
+        {GF("+CARECV:"), &TinyGsmSim7000SSL::handleReceiveURC},
+        {GF("+CADATAIND:"), &TinyGsmSim7000SSL::handleDataReadyURC},
+        {GF("+CASTATE:"), &TinyGsmSim7000SSL::handleSocketStateURC},
+        {GF("*PSNWID:"), &TinyGsmSim7000SSL::handleIgnoredURC},
+        {GF("*PSUTTZ:"), &TinyGsmSim7000SSL::handleIgnoredURC},
+        {GF("+CTZV:"), &TinyGsmSim7000SSL::handleIgnoredURC},
+        {GF("DST: "), &TinyGsmSim7000SSL::handleIgnoredURC},
+        {GF(AT_NL "SMS Ready" AT_NL), &TinyGsmSim7000SSL::handleModemResetURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool handleDataReadyURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool handleSocketStateURC(GsmLineBuffer&) {
+    int8_t mux   = streamGetIntBefore(',');
+    int8_t state = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (state != 1) {
+        sockets[mux]->sock_connected = false;
+        DBG("### Closed: ", mux);
       }
-      data = "";
-      return true;
-    } else if (data.endsWith(GF("*PSNWID:"))) {
-      streamSkipUntil('\n');  // Refresh network name by network
-      data = "";
-      DBG("### Network name updated.");
-      return true;
-    } else if (data.endsWith(GF("*PSUTTZ:"))) {
-      streamSkipUntil('\n');  // Refresh time and time zone by network
-      data = "";
-      DBG("### Network time and time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("+CTZV:"))) {
-      streamSkipUntil('\n');  // Refresh network time zone by network
-      data = "";
-      DBG("### Network time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("DST: "))) {
-      streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
-      data = "";
-      DBG("### Daylight savings time state updated.");
-      return true;
-    } else if (data.endsWith(GF(AT_NL "SMS Ready" AT_NL))) {
-      data = "";
-      DBG("### Unexpected module reset!");
-      init();
-      return true;
     }
-    return false;
+    return true;
+  }
+
+  bool handleModemResetURC(GsmLineBuffer&) {
+    DBG("### Unexpected module reset!");
+    init();
+    return true;
   }
 
  protected:
@@ -13,7 +13,6 @@
 // #define TINY_GSM_USE_HEX
 
 #define TINY_GSM_MUX_COUNT 12
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 
 #include "TinyGsmClientSIM70xx.h"
 #include "TinyGsmTCP.tpp"
@@ -24,6 +23,9 @@
 #include "TinyGsmNTP.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmSim7080, GSM_BUFFER_READ_AND_CHECK_SIZE, 1460,
+                      1460)
+
 class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
                        public TinyGsmTCP<TinyGsmSim7080, TINY_GSM_MUX_COUNT>,
                        public TinyGsmSSL<TinyGsmSim7080, TINY_GSM_MUX_COUNT>,
@@ -145,6 +147,10 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
     DBG(GF("### TinyGSM Compiled Module:  TinyGsmClientSIM7080"));
 
     bool gotATOK = false;
+#if defined TINY_GSM_NUMERIC_RESULTS
+    // Take either kind of OK while probing
+    numericResults = true;
+#endif
     for (uint32_t start = millis(); millis() - start < 10000L;) {
       sendAT(GF(""));
       int8_t resp = waitResponse(200L, GFP(GSM_OK), GFP(GSM_ERROR), GF("AT"));
@@ -161,11 +167,11 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
     }
     if (!gotATOK) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -190,9 +196,7 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
     }
   }
 
-  void maintainImpl() {
-    // Keep listening for modem URC's and proactively iterate through
-    // sockets asking if any data is avaiable
+  void modemRefreshSockets() {
     bool check_socks = false;
     for (int mux = 0; mux < TINY_GSM_MUX_COUNT; mux++) {
       GsmClientSim7080* sock = sockets[mux];
@@ -202,9 +206,8 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
       }
     }
     // modemGetAvailable checks all socks, so we only want to do it once
-    // modemGetAvailable calls modemGetConnected(), which also checks allf
+    // modemGetAvailable calls modemGetConnected(), which also checks all
     if (check_socks) { modemGetAvailable(0); }
-    while (stream.available()) { waitResponse(15, nullptr, nullptr); }
   }
 
   /*
@@ -215,6 +218,10 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
     bool success = true;
 
     bool gotATOK = false;
+#if defined TINY_GSM_NUMERIC_RESULTS
+    // Take either kind of OK while probing
+    numericResults = true;
+#endif
     for (uint32_t start = millis(); millis() - start < 10000L;) {
       sendAT(GF(""));
       int8_t resp = waitResponse(200L, GFP(GSM_OK), GFP(GSM_ERROR), GF("AT"));
@@ -324,6 +331,8 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
       sendAT(GF("+CNACT=0,1"));
       res = waitResponse(60000L, GF(AT_NL "+APP PDP: 0,ACTIVE"),
                          GF(AT_NL "+APP PDP: 0,DEACTIVE"));
+      // Don't retry if the modem refused outright
+      if (lastError() >= 0) { break; }
       waitResponse();
       ntries++;
     }
@@ -592,18 +601,9 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
       return 0;
     }
 
-    for (int i = 0; i < len_confirmed; i++) {
-      uint32_t startMillis = millis();
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
-      sockets[mux]->rx.put(c);
-    }
+    moveStreamToClient(mux, len_confirmed);
     waitResponse();
-    // make sure the sock available number is accurate again
-    sockets[mux]->sock_available = modemGetAvailable(mux);
+    accountRead(mux, size, len_confirmed);
     return len_confirmed;
   }
 
@@ -706,65 +706,57 @@ class TinyGsmSim7080 : public TinyGsmSim70xx<TinyGsmSim7080>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF("+CARECV:"))) {
-      int8_t  mux = streamGetIntBefore(',');
-      int16_t len = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->got_data = true;
-        if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-      }
-      data = "";
-      DBG("### Got Data:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("+CADATAIND:"))) {
-      int8_t mux = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->got_data = true;
-      }
-      data = "";
-      DBG("### Got Data:", mux);
-      return true;
-    } else if (data.endsWith(GF("+CASTATE:"))) {
-      int8_t mux   = streamGetIntBefore(',');
-      int8_t state = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        if (state != 1) {
-          sockets[mux]->sock_connected = false;
-          DBG("### Closed: ", mux);
-        }
+ protected:
+  const TinyGsmUrcHandler<TinyGsmSim7080>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmSim7080> handlers[] = {
+        {GF("+CARECV:"), &TinyGsmSim7080::handleReceiveURC},
+        {GF("+CADATAIND:"), &TinyGsmSim7080::handleDataReadyURC},
+        {GF("+CASTATE:"), &TinyGsmSim7080::handleSocketStateURC},
+        {GF("*PSNWID:"), &TinyGsmSim7080::handleIgnoredURC},
+        {GF("*PSUTTZ:"), &TinyGsmSim7080::handleIgnoredURC},
+        {GF("+CTZV:"), &TinyGsmSim7080::handleIgnoredURC},
+        {GF("DST: "), &TinyGsmSim7080::handleIgnoredURC},
+        {GF(AT_NL "SMS Ready" AT_NL), &TinyGsmSim7080::handleModemResetURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool handleDataReadyURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+    }
+    DBG("### Got Data:", mux);
+    return true;
+  }
+
+  bool handleSocketStateURC(GsmLineBuffer&) {
+    int8_t mux   = streamGetIntBefore(',');
+    int8_t state = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      if (state != 1) {
+        sockets[mux]->sock_connected = false;
+        DBG("### Closed: ", mux);
       }
-      data = "";
-      return true;
-    } else if (data.endsWith(GF("*PSNWID:"))) {
-      streamSkipUntil('\n');  // Refresh network name by network
-      data = "";
-      DBG("### Network name updated.");
-      return true;
-    } else if (data.endsWith(GF("*PSUTTZ:"))) {
-      streamSkipUntil('\n');  // Refresh time and time zone by network
-      data = "";
-      DBG("### Network time and time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("+CTZV:"))) {
-      streamSkipUntil('\n');  // Refresh network time zone by network
-      data = "";
-      DBG("### Network time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("DST: "))) {
-      streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
-      data = "";
-      DBG("### Daylight savings time state updated.");
-      return true;
-    } else if (data.endsWith(GF(AT_NL "SMS Ready" AT_NL))) {
-      data = "";
-      DBG("### Unexpected module reset!");
-      init();
-      data = "";
-      return true;
     }
-    return false;
+    return true;
+  }
+
+  bool handleModemResetURC(GsmLineBuffer&) {
+    DBG("### Unexpected module reset!");
+    init();
+    return true;
   }
 
  protected:
@@ -339,9 +339,6 @@ class TinyGsmSim70xx : public TinyGsmModem<SIM70xxType>,
     thisModem().waitResponse();
     return false;
   }
-  bool handleURCs(String& data) {
-    return thisModem().handleURCs(data);
-  }
 
  public:
   Stream& stream;
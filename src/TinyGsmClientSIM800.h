@@ -14,7 +14,6 @@
 // #define TINY_GSM_USE_HEX
 
 #define TINY_GSM_MUX_COUNT 5
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -49,6 +48,8 @@
 #include "TinyGsmNTP.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmSim800, GSM_BUFFER_READ_AND_CHECK_SIZE, 1460, 1460)
+
 enum SIM800RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -182,11 +183,11 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -547,13 +548,22 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
   }
 
   int16_t modemSend(const void* buff, size_t len, uint8_t mux) {
+#if defined TINY_GSM_SEND_WINDOW
+    if (!waitSendWindow(mux, len)) { return 0; }
+#endif
     sendAT(GF("+CIPSEND="), mux, ',', (uint16_t)len);
     if (waitResponse(GF(">")) != 1) { return 0; }
     stream.write(reinterpret_cast<const uint8_t*>(buff), len);
     stream.flush();
+#if defined TINY_GSM_SEND_WINDOW
+    // handleDataAcceptURC picks up the DATA ACCEPT
+    sendPending(mux, len);
+    return len;
+#else
     if (waitResponse(GF(AT_NL "DATA ACCEPT:")) != 1) { return 0; }
     streamSkipUntil(',');  // Skip mux
     return streamGetIntBefore('\n');
+#endif
   }
 
   size_t modemRead(size_t size, uint8_t mux) {
@@ -575,9 +585,9 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
     // SRGD NOTE:  Contrary to above (which is copied from AT command manual)
     // this is actually be the number of bytes that will be remaining in the
     // buffer after the read.
+#ifdef TINY_GSM_USE_HEX
     for (int i = 0; i < len_requested; i++) {
       uint32_t startMillis = millis();
-#ifdef TINY_GSM_USE_HEX
       while (stream.available() < 2 &&
              (millis() - startMillis < sockets[mux]->_timeout)) {
         TINY_GSM_YIELD();
@@ -588,15 +598,11 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
       buf[0] = stream.read();
       buf[1] = stream.read();
       char c = strtol(buf, nullptr, 16);
+      putCharToClient(mux, c);
+    }
 #else
-      while (!stream.available() &&
-             (millis() - startMillis < sockets[mux]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
+    moveStreamToClient(mux, len_requested);
 #endif
-      sockets[mux]->rx.put(c);
-    }
     // DBG("### READ:", len_requested, "from", mux);
     // sockets[mux]->sock_available = modemGetAvailable(mux);
     sockets[mux]->sock_available = len_confirmed;
@@ -632,66 +638,70 @@ class TinyGsmSim800 : public TinyGsmModem<TinyGsmSim800>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+CIPRXGET:"))) {
-      int8_t mode = streamGetIntBefore(',');
-      if (mode == 1) {
-        int8_t mux = streamGetIntBefore('\n');
-        if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-          sockets[mux]->got_data = true;
-        }
-        data = "";
-        // DBG("### Got Data:", mux);
-        return true;
-      } else {
-        data += mode;
-        return false;
-      }
-    } else if (data.endsWith(GF(AT_NL "+RECEIVE:"))) {
-      int8_t  mux = streamGetIntBefore(',');
-      int16_t len = streamGetIntBefore('\n');
+ protected:
+  const TinyGsmUrcHandler<TinyGsmSim800>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmSim800> handlers[] = {
+        {GF(AT_NL "+CIPRXGET:"), &TinyGsmSim800::handleRxGetURC},
+        {GF(AT_NL "+RECEIVE:"), &TinyGsmSim800::handleReceiveURC},
+        {GF("CLOSED" AT_NL), &TinyGsmSim800::handleClosedURC},
+#if defined TINY_GSM_SEND_WINDOW
+        {GF(AT_NL "DATA ACCEPT:"), &TinyGsmSim800::handleDataAcceptURC},
+#endif
+        {GF("*PSNWID:"), &TinyGsmSim800::handleIgnoredURC},
+        {GF("*PSUTTZ:"), &TinyGsmSim800::handleIgnoredURC},
+        {GF("+CTZV:"), &TinyGsmSim800::handleIgnoredURC},
+        {GF("DST:"), &TinyGsmSim800::handleIgnoredURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleRxGetURC(GsmLineBuffer&) {
+    int8_t mode = streamGetIntBefore(',');
+    if (mode == 1) {
+      int8_t mux = streamGetIntBefore('\n');
       if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
         sockets[mux]->got_data = true;
-        if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-      }
-      data = "";
-      // DBG("### Got Data:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("CLOSED" AT_NL))) {
-      int8_t nl   = data.lastIndexOf(AT_NL, data.length() - 8);
-      int8_t coma = data.indexOf(',', nl + 2);
-      int8_t mux  = data.substring(nl + 2, coma).toInt();
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
       }
-      data = "";
-      DBG("### Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("*PSNWID:"))) {
-      streamSkipUntil('\n');  // Refresh network name by network
-      data = "";
-      DBG("### Network name updated.");
-      return true;
-    } else if (data.endsWith(GF("*PSUTTZ:"))) {
-      streamSkipUntil('\n');  // Refresh time and time zone by network
-      data = "";
-      DBG("### Network time and time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("+CTZV:"))) {
-      streamSkipUntil('\n');  // Refresh network time zone by network
-      data = "";
-      DBG("### Network time zone updated.");
-      return true;
-    } else if (data.endsWith(GF("DST:"))) {
-      streamSkipUntil('\n');  // Refresh Network Daylight Saving Time by network
-      data = "";
-      DBG("### Daylight savings time state updated.");
+      // DBG("### Got Data:", mux);
       return true;
+    } else {
+      return false;
     }
-    return false;
   }
 
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    // DBG("### Got Data:", len, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer& data) {
+    int16_t nl  = data.lastIndexOf('\n', data.length() - 8);
+    int8_t  mux = atoi(data.c_str() + nl + 1);
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
+    }
+    DBG("### Closed: ", mux);
+    return true;
+  }
+
+#if defined TINY_GSM_SEND_WINDOW
+  bool handleDataAcceptURC(GsmLineBuffer&) {
+    // DATA ACCEPT:<mux>,<length>
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && len >= 0) {
+      sendAcked(mux, len, true);
+    }
+    return true;
+  }
+#endif
+
  public:
   Stream& stream;
 
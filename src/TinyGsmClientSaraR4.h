@@ -13,7 +13,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 7
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -40,6 +39,8 @@
 #include "TinyGsmBattery.tpp"
 #include "TinyGsmTemperature.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmSaraR4, GSM_BUFFER_READ_AND_CHECK_SIZE, 1024, 1024)
+
 enum SaraR4RegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -232,11 +233,11 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     String modemName = getModemName();
@@ -755,11 +756,11 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
     int16_t len = streamGetIntBefore(',');
     streamSkipUntil('\"');
 
-    for (int i = 0; i < len; i++) { moveCharFromStreamToFifo(mux); }
+    moveStreamToClient(mux, len);
     streamSkipUntil('\"');
     waitResponse();
     // DBG("### READ:", len, "from", mux);
-    sockets[mux]->sock_available = modemGetAvailable(mux);
+    accountRead(mux, size, len);
     return len;
   }
 
@@ -810,39 +811,46 @@ class TinyGsmSaraR4 : public TinyGsmModem<TinyGsmSaraR4>,
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF("+UUSORD:"))) {
-      int8_t  mux = streamGetIntBefore(',');
-      int16_t len = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->got_data = true;
-        // max size is 1024
-        if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
-      }
-      data = "";
-      DBG("### URC Data Received:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("+UUSOCL:"))) {
-      int8_t mux = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
-        sockets[mux]->sock_connected = false;
-      }
-      data = "";
-      DBG("### URC Sock Closed: ", mux);
-      return true;
-    } else if (data.endsWith(GF("+UUSOCO:"))) {
-      int8_t mux          = streamGetIntBefore('\n');
-      int8_t socket_error = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
-          socket_error == 0) {
-        sockets[mux]->sock_connected = true;
-      }
-      data = "";
-      DBG("### URC Sock Opened: ", mux);
-      return true;
+ protected:
+  const TinyGsmUrcHandler<TinyGsmSaraR4>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmSaraR4> handlers[] = {
+        {GF("+UUSORD:"), &TinyGsmSaraR4::handleReceiveURC},
+        {GF("+UUSOCL:"), &TinyGsmSaraR4::handleClosedURC},
+        {GF("+UUSOCO:"), &TinyGsmSaraR4::handleOpenedURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->got_data = true;
+      // max size is 1024
+      if (len >= 0 && len <= 1024) { sockets[mux]->sock_available = len; }
+    }
+    DBG("### URC Data Received:", len, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux]) {
+      sockets[mux]->sock_connected = false;
     }
-    return false;
+    DBG("### URC Sock Closed: ", mux);
+    return true;
+  }
+
+  bool handleOpenedURC(GsmLineBuffer&) {
+    int8_t mux          = streamGetIntBefore('\n');
+    int8_t socket_error = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT && sockets[mux] &&
+        socket_error == 0) {
+      sockets[mux]->sock_connected = true;
+    }
+    DBG("### URC Sock Opened: ", mux);
+    return true;
   }
 
  public:
@@ -12,7 +12,6 @@
 // #define TINY_GSM_DEBUG Serial
 
 #define TINY_GSM_MUX_COUNT 6
-#define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
 #ifdef AT_NL
 #undef AT_NL
 #endif
@@ -37,6 +36,9 @@
 #include "TinyGsmTime.tpp"
 #include "TinyGsmTemperature.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmSequansMonarch, GSM_BUFFER_READ_AND_CHECK_SIZE,
+                      1500, 1500)
+
 enum MonarchRegStatus {
   REG_NO_RESULT    = -1,
   REG_UNREGISTERED = 0,
@@ -206,11 +208,11 @@ class TinyGsmSequansMonarch
     sendAT(GF("E0"));  // Echo Off
     if (waitResponse() != 1) { return false; }
 
-#ifdef TINY_GSM_DEBUG
-    sendAT(GF("+CMEE=2"));  // turn on verbose error codes
-#else
-    sendAT(GF("+CMEE=0"));  // turn off error codes
+#if defined TINY_GSM_NUMERIC_RESULTS
+    enableNumericResults();  // Numeric result codes
 #endif
+
+    sendAT(GF("+CMEE=1"));  // turn on numeric error codes, for lastError()
     waitResponse();
 
     DBG(GF("### Modem:"), getModemName());
@@ -252,17 +254,19 @@ class TinyGsmSequansMonarch
     return waitResponse() == 1;
   }
 
-  void maintainImpl() {
+  void modemRefreshSockets() {
+    bool check_socks = false;
     for (int mux = 1; mux <= TINY_GSM_MUX_COUNT; mux++) {
       GsmClientSequansMonarch* sock = sockets[mux % TINY_GSM_MUX_COUNT];
       if (sock && sock->got_data) {
         sock->got_data       = false;
         sock->sock_available = modemGetAvailable(mux);
-        // modemGetConnected() always checks the state of ALL socks
-        modemGetConnected();
+        check_socks          = true;
       }
     }
-    while (stream.available()) { waitResponse(15, nullptr, nullptr); }
+    // modemGetConnected() always checks the state of ALL socks, so once is
+    // enough
+    if (check_socks) { modemGetConnected(); }
   }
 
   /*
@@ -588,19 +592,10 @@ class TinyGsmSequansMonarch
     if (waitResponse(GF("+SQNSRECV: ")) != 1) { return 0; }
     streamSkipUntil(',');  // Skip mux
     int16_t len = streamGetIntBefore('\n');
-    for (int i = 0; i < len; i++) {
-      uint32_t startMillis = millis();
-      while (!stream.available() &&
-             ((millis() - startMillis) <
-              sockets[mux % TINY_GSM_MUX_COUNT]->_timeout)) {
-        TINY_GSM_YIELD();
-      }
-      char c = stream.read();
-      sockets[mux % TINY_GSM_MUX_COUNT]->rx.put(c);
-    }
+    moveStreamToClient(mux % TINY_GSM_MUX_COUNT, len);
     // DBG("### READ:", len, "from", mux);
     waitResponse();
-    sockets[mux % TINY_GSM_MUX_COUNT]->sock_available = modemGetAvailable(mux);
+    accountRead(mux % TINY_GSM_MUX_COUNT, size, len);
     return len;
   }
 
@@ -654,30 +649,35 @@ class TinyGsmSequansMonarch
   /*
    * Utilities
    */
- public:
-  bool handleURCs(String& data) {
-    if (data.endsWith(GF(AT_NL "+SQNSRING:"))) {
-      int8_t  mux = streamGetIntBefore(',');
-      int16_t len = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
-          sockets[mux % TINY_GSM_MUX_COUNT]) {
-        sockets[mux % TINY_GSM_MUX_COUNT]->got_data       = true;
-        sockets[mux % TINY_GSM_MUX_COUNT]->sock_available = len;
-      }
-      data = "";
-      DBG("### URC Data Received:", len, "on", mux);
-      return true;
-    } else if (data.endsWith(GF("SQNSH: "))) {
-      int8_t mux = streamGetIntBefore('\n');
-      if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
-          sockets[mux % TINY_GSM_MUX_COUNT]) {
-        sockets[mux % TINY_GSM_MUX_COUNT]->sock_connected = false;
-      }
-      data = "";
-      DBG("### URC Sock Closed: ", mux);
-      return true;
+ protected:
+  const TinyGsmUrcHandler<TinyGsmSequansMonarch>* urcHandlers() {
+    static const TinyGsmUrcHandler<TinyGsmSequansMonarch> handlers[] = {
+        {GF(AT_NL "+SQNSRING:"), &TinyGsmSequansMonarch::handleReceiveURC},
+        {GF("SQNSH: "), &TinyGsmSequansMonarch::handleClosedURC},
+        {nullptr, nullptr}};
+    return handlers;
+  }
+
+  bool handleReceiveURC(GsmLineBuffer&) {
+    int8_t  mux = streamGetIntBefore(',');
+    int16_t len = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
+        sockets[mux % TINY_GSM_MUX_COUNT]) {
+      sockets[mux % TINY_GSM_MUX_COUNT]->got_data       = true;
+      sockets[mux % TINY_GSM_MUX_COUNT]->sock_available = len;
     }
-    return false;
+    DBG("### URC Data Received:", len, "on", mux);
+    return true;
+  }
+
+  bool handleClosedURC(GsmLineBuffer&) {
+    int8_t mux = streamGetIntBefore('\n');
+    if (mux >= 0 && mux < TINY_GSM_MUX_COUNT &&
+        sockets[mux % TINY_GSM_MUX_COUNT]) {
+      sockets[mux % TINY_GSM_MUX_COUNT]->sock_connected = false;
+    }
+    DBG("### URC Sock Closed: ", mux);
+    return true;
   }
 
  public:
@@ -16,7 +16,6 @@
 // XBee's do not support multi-plexing in transparent/command mode
 // The much more complicated API mode is needed for multi-plexing
 #define TINY_GSM_MUX_COUNT 1
-#define TINY_GSM_NO_MODEM_BUFFER
 // XBee's have a default guard time of 1 second (1000ms, 10 extra for safety
 // here)
 #define TINY_GSM_XBEE_GUARD_TIME 1010
@@ -45,6 +44,8 @@
 #include "TinyGsmTemperature.tpp"
 #include "TinyGsmBattery.tpp"
 
+TINY_GSM_MODEM_TRAITS(TinyGsmXBee, GSM_NO_MODEM_BUFFER, 0xFFFF, 0)
+
 // Use this to avoid too many entrances and exits from command mode.
 // The cellular Bee's often freeze up and won't respond when attempting
 // to enter command mode too many times.
@@ -181,7 +182,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
 
     int available() override {
       TINY_GSM_YIELD();
-      return at->stream.available();
+      return rx.size() + at->stream.available();
       /*
       if (!rx.size() || at->stream.available()) {
         at->maintain();
@@ -192,6 +193,14 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
 
     int read(uint8_t* buf, size_t size) override {
       TINY_GSM_YIELD();
+      // Anything peekBuffer() moved into the fifo comes first
+      size_t cnt = rx.get(buf, size);
+      if (cnt) {
+        size_t more = TinyGsmMin(size - cnt,
+                                 static_cast<size_t>(at->stream.available()));
+        return cnt + at->stream.readBytes(reinterpret_cast<char*>(buf + cnt),
+                                          more);
+      }
       return at->stream.readBytes(reinterpret_cast<char*>(buf), size);
       /*
       size_t cnt = 0;
@@ -215,6 +224,8 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
 
     int read() override {
       TINY_GSM_YIELD();
+      uint8_t c;
+      if (rx.get(&c)) { return c; }
       return at->stream.read();
       /*
       uint8_t c;
@@ -226,6 +237,7 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
     }
 
     int peek() override {
+      if (rx.size()) { return rx.peek(); }
       return at->stream.peek();
     }
     void flush() override {
@@ -257,6 +269,20 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
       IPAddress savedIP = at->savedIP;
       return TinyGsmStringFromIp(savedIP);
     }
+
+    // In transparent mode the data comes straight through the stream, so move
+    // what has arrived into the fifo to look at it in place
+    const uint8_t* peekBuffer(size_t& len) {
+      TINY_GSM_YIELD();
+      bindRxPool();
+      while (rx.writeable() && at->stream.available()) {
+        rx.put(at->stream.read());
+      }
+      int            n;
+      const uint8_t* p = rx.readableSpan(n);
+      len              = n;
+      return p;
+    }
   };
 
   /*
@@ -1319,8 +1345,10 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
       // After a send, verify the outgoing ip if it isn't set
       if (savedOperatingIP == IPAddress(0, 0, 0, 0)) {
         modemGetConnected(0);
-      } else if (len > 5) {
-        // After sending several characters, also re-check
+      } else if (len > 5 && sockets[0] && sockets[0]->connectedCheckDue()) {
+        // After sending several characters, also re-check, though not more
+        // often than TINY_GSM_CONNECTED_TTL since it means going into command
+        // mode
         // NOTE:  I'm intentionally not checking after every single character!
         modemGetConnected(0);
       }
@@ -1470,10 +1498,8 @@ class TinyGsmXBee : public TinyGsmModem<TinyGsmXBee>,
       TINY_GSM_YIELD();
     }
   }
-  // The XBee has no unsoliliced responses (URC's) when in command mode.
-  bool handleURCs(String&) {
-    return false;
-  }
+  // The XBee has no unsoliliced responses (URC's) when in command mode, so it
+  // keeps the default empty URC handler table.
 
   bool commandMode(uint8_t retries = 5) {
     // If we're already in command mode, move on
@@ -0,0 +1,119 @@
+/**
+ * @file       TinyGsmCommandBuffer.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Nov 2016
+ */
+
+#ifndef SRC_TINYGSMCOMMANDBUFFER_H_
+#define SRC_TINYGSMCOMMANDBUFFER_H_
+
+#include "TinyGsmCommon.h"
+
+/**
+ * @brief A fixed-size buffer for assembling an outgoing AT command.
+ *
+ * All the pieces of a command are printed into the buffer, using the usual
+ * Print formatting for numbers and PROGMEM strings, and then handed to the
+ * stream with a single write() call instead of one print() per piece. The
+ * buffer lives on the stack and never touches the heap. A command that does
+ * not fit is written out in buffer-sized pieces.
+ *
+ * A buffer created without a stream only holds on to the command until it is
+ * sent with sendTo(); anything that does not fit is dropped and flagged.
+ *
+ * @tparam N The size of the buffer
+ */
+template <uint16_t N>
+class TinyGsmCommandBuffer : public Print {
+ public:
+  TinyGsmCommandBuffer() : _stream(nullptr), _len(0), _overflow(false) {}
+  explicit TinyGsmCommandBuffer(Stream& stream)
+      : _stream(&stream),
+        _len(0),
+        _overflow(false) {}
+
+  using Print::write;
+
+  size_t write(uint8_t c) override {
+    if (_len >= N && !makeRoom()) return 0;
+    _b[_len++] = c;
+    return 1;
+  }
+
+  size_t write(const uint8_t* buffer, size_t size) override {
+    size_t left = size;
+    while (left) {
+      if (_len >= N && !makeRoom()) return size - left;
+      size_t n = N - _len;
+      if (n > left) n = left;
+      memcpy(_b + _len, buffer, n);
+      _len += n;
+      buffer += n;
+      left -= n;
+    }
+    return size;
+  }
+
+  /**
+   * @brief Print each of the arguments into the buffer
+   */
+  template <typename T>
+  inline void add(T last) {
+    print(last);
+  }
+
+  template <typename T, typename... Args>
+  inline void add(T head, Args... tail) {
+    print(head);
+    add(tail...);
+  }
+
+  /**
+   * @brief Write whatever is in the buffer to the stream and empty it
+   */
+  void send() {
+    if (_stream) sendTo(*_stream);
+  }
+
+  /**
+   * @brief Write whatever is in the buffer to a stream and empty it
+   */
+  void sendTo(Stream& stream) {
+    if (_len) stream.write(_b, _len);
+    _len = 0;
+  }
+
+  /**
+   * @brief Empty the buffer without sending it
+   */
+  void clear() {
+    _len      = 0;
+    _overflow = false;
+  }
+
+  /**
+   * @brief Whether anything was dropped because the buffer was full
+   */
+  bool overflowed() const {
+    return _overflow;
+  }
+
+ private:
+  bool makeRoom() {
+    if (!_stream) {
+      _overflow = true;
+      return false;
+    }
+    send();
+    return true;
+  }
+
+  Stream*  _stream;    /// The stream the command is sent to, if any
+  uint8_t  _b[N];      /// The assembled command
+  uint16_t _len;       /// The number of bytes in the buffer
+  bool     _overflow;  /// Whether anything was dropped
+};
+
+#endif  // SRC_TINYGSMCOMMANDBUFFER_H_
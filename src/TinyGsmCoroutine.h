@@ -0,0 +1,409 @@
+/**
+ * @file       TinyGsmCoroutine.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Nov 2016
+ *
+ * @brief Optional C++20 coroutine front-end for the queued AT commands.
+ *
+ * Include this after TinyGsmClient.h, with TINY_GSM_ASYNC_COMMANDS defined.
+ * On toolchains without coroutine support the header compiles to nothing.
+ *
+ * Only command() and sleep() are fully non-blocking.  waitForNetwork(),
+ * gprsConnect() and read() are built on the modem's ordinary blocking calls,
+ * so each check they make holds up the loop for an AT round trip (or the
+ * whole bearer set-up, for gprsConnect()); they only yield between checks.
+ * There is no awaitable socket connect; call the client's connect() directly.
+ *
+ * @code
+ * TinyGsm                modem(SerialAT);
+ * TinyGsmAsync<TinyGsm>  async(modem);
+ *
+ * TinyGsmTask<> session() {
+ *   if (!co_await async.gprsConnect(apn)) co_return;
+ *   TinyGsmCommandResult csq = co_await async.command(1000L, GF("+CSQ"));
+ *   ...
+ * }
+ *
+ * TinyGsmTask<> task = session();
+ * void setup() { task.start(); }
+ * void loop() { async.poll(); }
+ * @endcode
+ */
+
+#ifndef SRC_TINYGSMCOROUTINE_H_
+#define SRC_TINYGSMCOROUTINE_H_
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define TINY_GSM_HAS_COROUTINES
+#endif
+#endif
+
+#if defined TINY_GSM_HAS_COROUTINES && !defined TINY_GSM_ASYNC_COMMANDS
+#error "TinyGsmCoroutine.h needs TINY_GSM_ASYNC_COMMANDS to be defined"
+#elif defined TINY_GSM_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <tuple>
+#include <utility>
+
+#include "TinyGsmCommon.h"
+
+// The most coroutines that can be waiting in TinyGsmAsync::sleep at once
+#ifndef TINY_GSM_CO_SLEEPERS
+#define TINY_GSM_CO_SLEEPERS 8
+#endif
+
+// How often the coroutine helpers check on something they are waiting for
+#ifndef TINY_GSM_CO_POLL_MS
+#define TINY_GSM_CO_POLL_MS 100
+#endif
+
+/**
+ * @brief The promise parts shared by every TinyGsmTask
+ */
+struct TinyGsmTaskPromiseBase {
+  std::coroutine_handle<> continuation;
+
+  // Tasks are lazy; they run when started or awaited
+  std::suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  // When a task finishes, carry on with whoever was awaiting it
+  struct FinalAwaiter {
+    bool await_ready() noexcept {
+      return false;
+    }
+    template <typename P>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+      std::coroutine_handle<> next = h.promise().continuation;
+      return next ? next : std::noop_coroutine();
+    }
+    void await_resume() noexcept {}
+  };
+
+  FinalAwaiter final_suspend() noexcept {
+    return {};
+  }
+
+  void unhandled_exception() {
+    std::terminate();
+  }
+};
+
+template <typename T>
+struct TinyGsmTaskPromise : TinyGsmTaskPromiseBase {
+  T value{};
+
+  void return_value(T v) {
+    value = std::move(v);
+  }
+  T result() {
+    return std::move(value);
+  }
+};
+
+template <>
+struct TinyGsmTaskPromise<void> : TinyGsmTaskPromiseBase {
+  void return_void() {}
+  void result() {}
+};
+
+/**
+ * @brief A coroutine that produces a T.
+ *
+ * A task can be awaited from another coroutine, or started from ordinary code
+ * with start() and then checked with done() and result(). Either way it only
+ * makes progress while TinyGsmAsync::poll() is being called.
+ *
+ * @tparam T The type the coroutine co_returns
+ */
+template <typename T = void>
+class TinyGsmTask {
+ public:
+  struct promise_type : TinyGsmTaskPromise<T> {
+    TinyGsmTask get_return_object() {
+      return TinyGsmTask(
+          std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+  };
+
+  TinyGsmTask(TinyGsmTask&& other) noexcept
+      : _h(std::exchange(other._h, nullptr)),
+        _started(other._started) {}
+  TinyGsmTask(const TinyGsmTask&)            = delete;
+  TinyGsmTask& operator=(const TinyGsmTask&) = delete;
+  ~TinyGsmTask() {
+    if (_h) _h.destroy();
+  }
+
+  /**
+   * @brief Run the task up to its first suspension point
+   */
+  void start() {
+    if (!_h || _started) return;
+    _started = true;
+    _h.resume();
+  }
+
+  /**
+   * @brief Whether the task has run to completion
+   */
+  bool done() const {
+    return !_h || _h.done();
+  }
+
+  /**
+   * @brief The value the task returned; only valid once done()
+   */
+  T result() {
+    return _h.promise().result();
+  }
+
+  bool await_ready() const noexcept {
+    return done();
+  }
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) {
+    _h.promise().continuation = awaiting;
+    _started                  = true;
+    return _h;
+  }
+  T await_resume() {
+    return _h.promise().result();
+  }
+
+ private:
+  explicit TinyGsmTask(std::coroutine_handle<promise_type> h)
+      : _h(h),
+        _started(false) {}
+
+  std::coroutine_handle<promise_type> _h;
+  bool                                _started;
+};
+
+/**
+ * @brief The outcome of an AT command awaited with TinyGsmAsync::command
+ */
+struct TinyGsmCommandResult {
+  int8_t result;  /// 1 for OK, 2 for ERROR, 0 for a time-out
+  char   response[TINY_GSM_RESPONSE_BUFFER];  /// The tail of the response
+
+  explicit operator bool() const {
+    return result == 1;
+  }
+};
+
+/**
+ * @brief Awaitable modem operations, driven by poll().
+ *
+ * Wraps a modem built with TINY_GSM_ASYNC_COMMANDS. AT commands awaited with
+ * command() go through the modem's command queue, so a single thread can
+ * drive several coroutines without any of them sitting in waitResponse. The
+ * higher-level helpers block while they check on the modem; see each one.
+ * Call poll() from the main loop.
+ *
+ * @tparam modemType The modem class, usually TinyGsm
+ */
+template <class modemType>
+class TinyGsmAsync {
+ public:
+  explicit TinyGsmAsync(modemType& modem) : modem(modem) {
+    for (uint8_t i = 0; i < TINY_GSM_CO_SLEEPERS; i++) {
+      sleepers[i].handle = nullptr;
+    }
+  }
+
+  /**
+   * @brief Advance the modem's command queue and wake any coroutine whose
+   * sleep is over
+   */
+  void poll() {
+    modem.poll();
+    // Collect first, so a coroutine that goes straight back to sleep waits
+    // for the next poll
+    std::coroutine_handle<> due[TINY_GSM_CO_SLEEPERS];
+    uint8_t                 n   = 0;
+    uint32_t                now = millis();
+    for (uint8_t i = 0; i < TINY_GSM_CO_SLEEPERS; i++) {
+      Sleeper& s = sleepers[i];
+      if (!s.handle || now - s.start < s.ms) continue;
+      due[n++] = s.handle;
+      s.handle = nullptr;
+    }
+    for (uint8_t i = 0; i < n; i++) { due[i].resume(); }
+  }
+
+  /**
+   * @brief Awaitable for one AT command sent through the command queue
+   */
+  template <typename... Args>
+  class CommandAwaiter {
+   public:
+    CommandAwaiter(modemType& modem, uint32_t timeout_ms, Args... cmd)
+        : _modem(modem),
+          _timeout_ms(timeout_ms),
+          _cmd(cmd...) {}
+
+    bool await_ready() {
+      return false;
+    }
+    bool await_suspend(std::coroutine_handle<> h) {
+      _h                  = h;
+      GsmCommandHandle id = std::apply(
+          [this](Args... cmd) {
+            return _modem.submitAT(_timeout_ms, &CommandAwaiter::done, this,
+                                   cmd...);
+          },
+          _cmd);
+      if (id) return true;
+      // The queue is full; report it as a failure without suspending
+      _res.result      = 0;
+      _res.response[0] = '\0';
+      return false;
+    }
+    TinyGsmCommandResult await_resume() {
+      return _res;
+    }
+
+   private:
+    static void done(GsmCommandHandle, int8_t result, const char* response,
+                     void* arg) {
+      CommandAwaiter* self = static_cast<CommandAwaiter*>(arg);
+      self->_res.result    = result;
+      strncpy(self->_res.response, response, sizeof(self->_res.response) - 1);
+      self->_res.response[sizeof(self->_res.response) - 1] = '\0';
+      self->_h.resume();
+    }
+
+    modemType&              _modem;
+    uint32_t                _timeout_ms;
+    std::tuple<Args...>     _cmd;
+    std::coroutine_handle<> _h;
+    TinyGsmCommandResult    _res;
+  };
+
+  /**
+   * @brief Send an AT command and await its result
+   *
+   * @param timeout_ms The time to wait for the response once it has been sent
+   * @param cmd The command, as for sendAT
+   */
+  template <typename... Args>
+  CommandAwaiter<Args...> command(uint32_t timeout_ms, Args... cmd) {
+    return CommandAwaiter<Args...>(modem, timeout_ms, cmd...);
+  }
+
+  /**
+   * @brief Awaitable that resumes from poll() after a delay
+   */
+  class SleepAwaiter {
+   public:
+    SleepAwaiter(TinyGsmAsync& owner, uint32_t ms) : _owner(owner), _ms(ms) {}
+
+    bool await_ready() {
+      return false;
+    }
+    bool await_suspend(std::coroutine_handle<> h) {
+      for (uint8_t i = 0; i < TINY_GSM_CO_SLEEPERS; i++) {
+        Sleeper& s = _owner.sleepers[i];
+        if (s.handle) continue;
+        s.handle = h;
+        s.start  = millis();
+        s.ms     = _ms;
+        return true;
+      }
+      // No room to sleep; carry on straight away
+      return false;
+    }
+    void await_resume() {}
+
+   private:
+    TinyGsmAsync& _owner;
+    uint32_t      _ms;
+  };
+
+  /**
+   * @brief Await a delay without blocking the other coroutines
+   */
+  SleepAwaiter sleep(uint32_t ms) {
+    return SleepAwaiter(*this, ms);
+  }
+
+  /**
+   * @brief Wait for the modem to register on the network
+   *
+   * @note Each check is a call to the modem's isNetworkConnected(), which
+   * blocks for its AT round trip; the coroutine only yields between checks,
+   * every TINY_GSM_CO_POLL_MS.
+   *
+   * @param timeout_ms The longest time to wait
+   */
+  TinyGsmTask<bool> waitForNetwork(uint32_t timeout_ms = 60000L) {
+    for (uint32_t start = millis(); millis() - start < timeout_ms;) {
+      if (modem.isNetworkConnected()) co_return true;
+      co_await sleep(TINY_GSM_CO_POLL_MS);
+    }
+    co_return false;
+  }
+
+  /**
+   * @brief Wait for the network, then open the GPRS connection
+   *
+   * @note The network is waited for as in waitForNetwork(), blocking for each
+   * check, and the connection itself is made with the modem's gprsConnect(),
+   * which blocks while the bearer comes up.
+   */
+  TinyGsmTask<bool> gprsConnect(const char* apn, const char* user = nullptr,
+                                const char* pwd        = nullptr,
+                                uint32_t    timeout_ms = 60000L) {
+    if (!co_await waitForNetwork(timeout_ms)) co_return false;
+    co_return modem.gprsConnect(apn, user, pwd);
+  }
+
+  /**
+   * @brief Wait for data on a client and read what is there
+   *
+   * @note Each check calls the client's available() and connected(), and the
+   * read is the client's read(); these block for the AT round trips and the
+   * maintain() they make.  The coroutine only yields between checks, every
+   * TINY_GSM_CO_POLL_MS.
+   *
+   * @param client The client to read from
+   * @param buf The buffer to read into
+   * @param size The most bytes to read
+   * @param timeout_ms The longest time to wait for any data
+   * @return The number of bytes read; 0 if the time ran out or the connection
+   * was closed first
+   */
+  template <class clientType>
+  TinyGsmTask<int> read(clientType& client, uint8_t* buf, size_t size,
+                        uint32_t timeout_ms = 5000L) {
+    for (uint32_t start = millis();;) {
+      int avail = client.available();
+      if (avail > 0) {
+        co_return client.read(buf,
+                              TinyGsmMin(size, static_cast<size_t>(avail)));
+      }
+      if (!client.connected() || millis() - start >= timeout_ms) co_return 0;
+      co_await sleep(TINY_GSM_CO_POLL_MS);
+    }
+  }
+
+ private:
+  struct Sleeper {
+    std::coroutine_handle<> handle;  // nullptr if the slot is free
+    uint32_t                start;
+    uint32_t                ms;
+  };
+
+  modemType& modem;
+  Sleeper    sleepers[TINY_GSM_CO_SLEEPERS];
+};
+
+#endif  // TINY_GSM_HAS_COROUTINES
+
+#endif  // SRC_TINYGSMCOROUTINE_H_
@@ -1,23 +1,169 @@
 #ifndef TinyGsmFifo_h
 #define TinyGsmFifo_h
 
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// std::atomic gives the read and write positions the right memory ordering
+// where the standard library has it.  AVR has no <atomic>, but it is single
+// core and loads and stores of an 8-bit position are atomic there, so a
+// volatile position with a compiler barrier is enough.
+#if !defined(__AVR__) && defined(__has_include)
+#if __has_include(<atomic>)
+#define TINY_GSM_FIFO_HAS_ATOMIC
+#endif
+#endif
+
+#if defined TINY_GSM_FIFO_HAS_ATOMIC
+#include <atomic>
+#endif
+
+/**
+ * @brief The smallest unsigned type that can hold a position in a FIFO of N
+ * items
+ */
+template <unsigned N, bool Byte = (N <= 0x100UL), bool Word = (N <= 0x10000UL)>
+struct TinyGsmFifoIndex {
+  typedef uint32_t type;
+};
+template <unsigned N>
+struct TinyGsmFifoIndex<N, true, true> {
+  typedef uint8_t type;
+};
+template <unsigned N>
+struct TinyGsmFifoIndex<N, false, true> {
+  typedef uint16_t type;
+};
+
+/**
+ * @brief Copy items in or out of a FIFO; assignment for any type, memcpy for
+ * bytes
+ */
+template <class T>
+inline void TinyGsmFifoCopy(T* dst, const T* src, size_t n) {
+  for (size_t i = 0; i < n; i++) { dst[i] = src[i]; }
+}
+inline void TinyGsmFifoCopy(uint8_t* dst, const uint8_t* src, size_t n) {
+#if defined(__GNUC__)
+  // Hide the bound the 8- or 16-bit positions put on n.  Knowing it, GCC
+  // inlines the copy as "rep movs" on x86, several times slower than calling
+  // memcpy for runs of a few dozen bytes.
+  __asm__("" : "+r"(n));
+#endif
+  memcpy(dst, src, n);
+}
+inline void TinyGsmFifoCopy(char* dst, const char* src, size_t n) {
+  TinyGsmFifoCopy(reinterpret_cast<uint8_t*>(dst),
+                  reinterpret_cast<const uint8_t*>(src), n);
+}
+
+/**
+ * @brief Storage for a FIFO whose size is fixed at compile time
+ */
 template <class T, unsigned N>
-class TinyGsmFifo {
+class TinyGsmFifoArray {
+  static_assert(N >= 2, "A TinyGsmFifo needs at least two slots");
+
+ protected:
+  typedef typename TinyGsmFifoIndex<N>::type Index;
+
+  static unsigned _size() {
+    return N;
+  }
+  T* _data() {
+    return _b;
+  }
+  const T* _data() const {
+    return _b;
+  }
+
+  T _b[N];  /// The buffer, containing 'N' items of type 'T'
+};
+
+/**
+ * @brief Storage for a FIFO over a buffer supplied at run time
+ *
+ * Its positions are 16 bits wide, so on AVR it can't be fed from an interrupt;
+ * use a TinyGsmFifo with a fixed size of up to 256 items for that.  The
+ * clients' receive FIFOs are of this kind so that setRxBuffer() can swap the
+ * buffer, which is fine because the library only ever fills them from the
+ * main loop.
+ */
+template <class T>
+class TinyGsmFifoExternal {
+ protected:
+  typedef uint16_t Index;
+
+  TinyGsmFifoExternal() : _b(nullptr), _n(0) {}
+
+  unsigned _size() const {
+    return _n;
+  }
+  T* _data() {
+    return _b;
+  }
+  const T* _data() const {
+    return _b;
+  }
+
+  T*       _b;  /// The buffer
+  uint16_t _n;  /// The number of items the buffer holds
+};
+
+/**
+ * @brief The ring buffer behind TinyGsmFifo, over either kind of storage.
+ *
+ * One context may write to the FIFO while another reads from it, for example a
+ * UART interrupt feeding the main loop, without any locking: each position is
+ * only changed by its own side and is published only after the items it covers
+ * have been copied. clear() is the exception and must only be called when
+ * neither side is busy.
+ *
+ * When the size is a power of two the positions wrap with a mask instead of
+ * a comparison.
+ *
+ * @tparam T The type of the items
+ * @tparam Storage TinyGsmFifoArray or TinyGsmFifoExternal
+ */
+template <class T, class Storage>
+class TinyGsmFifoImpl : protected Storage {
+  typedef typename Storage::Index Index;
+  using Storage::_data;
+  using Storage::_size;
+#if defined TINY_GSM_FIFO_HAS_ATOMIC
+  typedef std::atomic<Index> Position;
+#else
+  typedef volatile Index Position;
+#endif
+
  public:
   /**
    * @brief Construct a new Tiny Gsm Fifo object, setting the head and tail to
    * 0.
    */
-  TinyGsmFifo() {
+  TinyGsmFifoImpl() {
     clear();
   }
 
+  // Like clear(), copying is only safe while neither side is busy
+  TinyGsmFifoImpl(const TinyGsmFifoImpl& other) : Storage(other) {
+    _store(_r, _relaxed(other._r));
+    _store(_w, _relaxed(other._w));
+  }
+  TinyGsmFifoImpl& operator=(const TinyGsmFifoImpl& other) {
+    Storage::operator=(other);
+    _store(_r, _relaxed(other._r));
+    _store(_w, _relaxed(other._w));
+    return *this;
+  }
+
   /**
    * @brief Clear the FIFO - set the read and write positions to 0
    */
   void clear() {
-    _r = 0;
-    _w = 0;
+    _store(_r, 0);
+    _store(_w, 0);
   }
 
   // writing thread/context API
@@ -29,7 +175,7 @@ class TinyGsmFifo {
    * @return *true* The buffer has free space.
    * @return *false* There is no space left in the buffer.
    */
-  bool writeable(void) {
+  bool writeable(void) const {
     return free() > 0;
   }
 
@@ -38,9 +184,10 @@ class TinyGsmFifo {
    *
    * @return *int*  The number number of free positions in the buffer
    */
-  int free(void) {
-    int s = _r - _w;     // Check if the read is ahead of the write
-    if (s <= 0) s += N;  // if not wrap
+  int free(void) const {
+    if (!_size()) return 0;
+    int s = static_cast<int>(_load(_r)) - _relaxed(_w);  // read ahead of write?
+    if (s <= 0) s += _size();                             // if not wrap
     return s - 1;  // return the difference between r and w, accounting for wrap
   }
 
@@ -52,14 +199,13 @@ class TinyGsmFifo {
    * @return *false* Nothing was added to the buffer
    */
   bool put(const T& c) {
-    int i = _w;       // check the write position
-    int j = i;        // set the spot for the new item to the write position
-    i     = _inc(i);  // check where the next increment of the write will be
-    if (i == _r)  // make sure the next spot isn't the position of the read (ie,
-                  // the buffer is full)
-      return false;
-    _b[j] = c;  // add the item at position j
-    _w    = i;  // bump the write position
+    if (!_size()) return false;
+    Index w = _relaxed(_w);
+    Index i = _inc(w);
+    // the buffer is full if the next spot is the read position
+    if (i == _load(_r)) return false;
+    _data()[w] = c;
+    _store(_w, i);
     return true;
   }
 
@@ -83,37 +229,60 @@ class TinyGsmFifo {
       }
       // check free space
       if (c < f) f = c;
-      int w = _w;
-      int m = N - w;
+      Index w = _relaxed(_w);
+      int   m = _size() - w;
       // check wrap
       if (f > m) f = m;
-      memcpy(&_b[w], p, f);
-      _w = _inc(w, f);
+      TinyGsmFifoCopy(_data() + w, p, f);
+      _store(_w, _inc(w, f));
       c -= f;
       p += f;
     }
     return n - c;
   }
 
+  /**
+   * @brief Get the longest run of free positions that can be written to
+   * directly, without wrapping.  Call commit() once the items are in place.
+   *
+   * @param n Set to the number of positions in the run
+   * @return *T** The first free position
+   */
+  T* writableSpan(int& n) {
+    Index w = _relaxed(_w);
+    n       = free();
+    if (n > static_cast<int>(_size() - w)) n = _size() - w;
+    return _data() + w;
+  }
+
+  /**
+   * @brief Add items that were written in place after writableSpan()
+   *
+   * @param n The number of items written; no more than writableSpan() gave
+   */
+  void commit(int n) {
+    _store(_w, _inc(_relaxed(_w), n));
+  }
+
   // reading thread/context API
   // --------------------------------------------------------
 
-  bool readable(void) {
-    return (_r != _w);
+  bool readable(void) const {
+    return _relaxed(_r) != _load(_w);
   }
 
-  size_t size(void) {
-    int s = _w - _r;
-    if (s < 0) s += N;
+  size_t size(void) const {
+    int s = static_cast<int>(_load(_w)) - _relaxed(_r);
+    if (s < 0) s += _size();
     return s;
   }
 
   bool get(T* p) {
-    int r = _r;
-    if (r == _w)  // !readable()
+    Index r = _relaxed(_r);
+    if (r == _load(_w))  // !readable()
       return false;
-    *p = _b[r];
-    _r = _inc(r);
+    *p = _data()[r];
+    _store(_r, _inc(r));
     return true;
   }
 
@@ -130,38 +299,131 @@ class TinyGsmFifo {
       }
       // check available data
       if (c < f) f = c;
-      int r = _r;
-      int m = N - r;
+      Index r = _relaxed(_r);
+      int   m = _size() - r;
       // check wrap
       if (f > m) f = m;
-      memcpy(p, &_b[r], f);
-      _r = _inc(r, f);
+      TinyGsmFifoCopy(p, _data() + r, f);
+      _store(_r, _inc(r, f));
       c -= f;
       p += f;
     }
     return n - c;
   }
 
-  uint8_t peek() {
-    return _b[_r];
+  /**
+   * @brief Get the longest run of items that can be read in place, without
+   * wrapping.  Call consume() once they have been dealt with.
+   *
+   * @param n Set to the number of items in the run
+   * @return *const T** The first item in the run
+   */
+  const T* readableSpan(int& n) const {
+    Index r = _relaxed(_r);
+    n       = size();
+    if (n > static_cast<int>(_size() - r)) n = _size() - r;
+    return _data() + r;
   }
 
- private:
   /**
-   * @brief Get the next increment spot in the buffer, accounting for the size
-   * of each item in the buffer
+   * @brief Remove items that were read in place after readableSpan()
    *
-   * @param i
-   * @param n
-   * @return *int*
+   * @param n The number of items to remove; no more than readableSpan() gave
+   */
+  void consume(int n) {
+    _store(_r, _inc(_relaxed(_r), n));
+  }
+
+  /**
+   * @brief The next item to be read, without removing it; only meaningful if
+   * the buffer is readable.  A FIFO with no buffer gives T().
+   */
+  T peek() const {
+    if (!_size()) return T();
+    return _data()[_relaxed(_r)];
+  }
+
+ private:
+  /**
+   * @brief Get the position n items on from position i, wrapping at the end of
+   * the buffer
    */
-  int _inc(int i, int n = 1) {
-    return (i + n) % N;
+  Index _inc(Index i, int n = 1) const {
+    unsigned s = _size();
+    unsigned j = i + n;
+    if ((s & (s - 1)) == 0) return j & (s - 1);
+    return j >= s ? j - s : j;
+  }
+
+  // Reads the other side's position, seeing everything it wrote before
+  // publishing it
+  static Index _load(const Position& p) {
+#if defined TINY_GSM_FIFO_HAS_ATOMIC
+    return p.load(std::memory_order_acquire);
+#else
+    Index v = p;
+    _barrier();
+    return v;
+#endif
   }
 
-  T   _b[N];  /// The buffer, containing 'N' items of type 'T'
-  int _w;     /// The write position in the buffer
-  int _r;     /// The read position in the buffer
+  // Reads our own side's position
+  static Index _relaxed(const Position& p) {
+#if defined TINY_GSM_FIFO_HAS_ATOMIC
+    return p.load(std::memory_order_relaxed);
+#else
+    return p;
+#endif
+  }
+
+  // Publishes our own side's position after the items it covers
+  static void _store(Position& p, Index v) {
+#if defined TINY_GSM_FIFO_HAS_ATOMIC
+    p.store(v, std::memory_order_release);
+#else
+    _barrier();
+    p = v;
+#endif
+  }
+
+#if !defined TINY_GSM_FIFO_HAS_ATOMIC
+  static void _barrier() {
+#if defined(__GNUC__)
+    __asm__ __volatile__("" ::: "memory");
+#endif
+  }
+#endif
+
+  Position _w;  /// The write position in the buffer
+  Position _r;  /// The read position in the buffer
+};
+
+/**
+ * @brief A ring buffer of N - 1 items of type T.
+ *
+ * @tparam T The type of the items
+ * @tparam N The number of slots; one is always kept empty.  With N = 0 the
+ * FIFO has no storage of its own and works over a buffer handed to setBuffer().
+ */
+template <class T, unsigned N>
+class TinyGsmFifo : public TinyGsmFifoImpl<T, TinyGsmFifoArray<T, N> > {};
+
+template <class T>
+class TinyGsmFifo<T, 0> : public TinyGsmFifoImpl<T, TinyGsmFifoExternal<T> > {
+ public:
+  /**
+   * @brief Use a buffer of n items, emptying the FIFO.  Like clear(), this is
+   * only safe while neither side is busy.
+   *
+   * @param buf The buffer; nullptr for none
+   * @param n The size of the buffer, at most 65535 items; one slot is always
+   * kept empty
+   */
+  void setBuffer(T* buf, size_t n) {
+    this->_b = buf;
+    this->_n = !buf ? 0 : n > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(n);
+    this->clear();
+  }
 };
 
 #endif
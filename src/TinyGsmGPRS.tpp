@@ -142,6 +142,8 @@ class TinyGsmGPRS {
     for (uint32_t start = millis(); millis() - start < timeout_ms;) {
       thisModem().sendAT(GF("+CPIN?"));
       if (thisModem().waitResponse(GF("+CPIN:")) != 1) {
+        SimStatus status;
+        if (simStatusFromError(status)) { return status; }
         delay(1000);
         continue;
       }
@@ -159,6 +161,23 @@ class TinyGsmGPRS {
     return SIM_ERROR;
   }
 
+  // Whether the +CME ERROR that AT+CPIN? failed with settles the SIM status,
+  // so that there is no point in asking again
+  bool simStatusFromError(SimStatus& status) {
+    switch (thisModem().lastError()) {
+      case 10:  // SIM not inserted
+      case 13:  // SIM failure
+      case 15:  // SIM wrong
+        status = SIM_ERROR;
+        return true;
+      case 11:  // SIM PIN required
+      case 12:  // SIM PUK required
+        status = SIM_LOCKED;
+        return true;
+      default: return false;
+    }
+  }
+
   /*
    * GPRS functions
    */
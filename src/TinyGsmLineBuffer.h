@@ -0,0 +1,103 @@
+/**
+ * @file       TinyGsmLineBuffer.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Nov 2016
+ */
+
+#ifndef SRC_TINYGSMLINEBUFFER_H_
+#define SRC_TINYGSMLINEBUFFER_H_
+
+#include "TinyGsmCommon.h"
+
+/**
+ * @brief A fixed-capacity buffer holding the tail of a modem response.
+ *
+ * Used by waitResponse and the URC handlers in place of a String, so listening to
+ * the modem never touches the heap. When the buffer fills up the older half
+ * is dropped, which always leaves enough of the current line to inspect a
+ * URC.
+ *
+ * @tparam N The capacity of the buffer, including the terminating NUL
+ */
+template <uint16_t N>
+class TinyGsmLineBuffer {
+ public:
+  TinyGsmLineBuffer() {
+    clear();
+  }
+
+  /**
+   * @brief Empty the buffer
+   */
+  void clear() {
+    _len  = 0;
+    _b[0] = '\0';
+  }
+
+  /**
+   * @brief Append a character, dropping the older half of the buffer if it is
+   * full
+   *
+   * @param c The character to append
+   */
+  void add(char c) {
+    if (_len >= N - 1) {
+      uint16_t keep = (N - 1) / 2;
+      memmove(_b, _b + _len - keep, keep);
+      _len = keep;
+    }
+    _b[_len++] = c;
+    _b[_len]   = '\0';
+  }
+
+  TinyGsmLineBuffer& operator+=(char c) {
+    add(c);
+    return *this;
+  }
+
+  uint16_t length() const {
+    return _len;
+  }
+
+  const char* c_str() const {
+    return _b;
+  }
+
+  /**
+   * @brief Check if the buffer ends with a (possibly PROGMEM) string
+   */
+  bool endsWith(GsmConstStr suffix) const {
+    if (!suffix) return false;
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+    const char* s    = reinterpret_cast<const char*>(suffix);
+    size_t      slen = strlen_P(s);
+    return slen <= _len && strcmp_P(_b + _len - slen, s) == 0;
+#else
+    size_t slen = strlen(suffix);
+    return slen <= _len && strcmp(_b + _len - slen, suffix) == 0;
+#endif
+  }
+
+  /**
+   * @brief Find the last occurrence of a character at or before a position
+   *
+   * @param c The character to look for
+   * @param from The position to start looking backwards from
+   * @return *int* The position of the character, or -1 if not found
+   */
+  int lastIndexOf(char c, int from) const {
+    if (from >= _len) from = _len - 1;
+    for (int i = from; i >= 0; i--) {
+      if (_b[i] == c) return i;
+    }
+    return -1;
+  }
+
+ private:
+  char     _b[N];  /// The buffered characters, NUL terminated
+  uint16_t _len;   /// The number of buffered characters
+};
+
+#endif  // SRC_TINYGSMLINEBUFFER_H_
@@ -0,0 +1,145 @@
+/**
+ * @file       TinyGsmMatcher.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Nov 2016
+ */
+
+#ifndef SRC_TINYGSMMATCHER_H_
+#define SRC_TINYGSMMATCHER_H_
+
+#include "TinyGsmCommon.h"
+
+/**
+ * @brief Incremental matcher for a small set of response patterns.
+ *
+ * Each pattern keeps the length of its longest prefix that is also a suffix of
+ * everything fed so far, so every received byte costs one comparison per
+ * pattern instead of an endsWith() over the whole response. On a mismatch the
+ * state falls back KMP-style by comparing the pattern against itself, so the
+ * received data never has to be kept or re-scanned.
+ *
+ * Patterns are GsmConstStr and may live in PROGMEM.
+ *
+ * @tparam N The maximum number of patterns
+ */
+template <uint8_t N>
+class TinyGsmMatcher {
+ public:
+  TinyGsmMatcher() : _count(0) {}
+
+  /**
+   * @brief Add a pattern to the matcher
+   *
+   * A nullptr pattern still takes up a slot, but never matches, so slot numbers
+   * stay stable for optional responses.
+   *
+   * @param p The pattern to add
+   * @return *uint8_t* The 1-based slot of the pattern, or 0 if the matcher is
+   * full
+   */
+  uint8_t add(GsmConstStr p) {
+    if (_count >= N) return 0;
+    _p[_count]     = p;
+    _len[_count]   = p ? strLen(p) : 0;
+    _state[_count] = 0;
+    return ++_count;
+  }
+
+  /**
+   * @brief The number of slots in use
+   */
+  uint8_t size() const {
+    return _count;
+  }
+
+  /**
+   * @brief Remove all patterns
+   */
+  void clear() {
+    _count = 0;
+  }
+
+  /**
+   * @brief Forget all partial matches, as if nothing had been fed yet
+   */
+  void restart() {
+    memset(_state, 0, sizeof(_state));
+  }
+
+  /**
+   * @brief Advance every pattern by one received character
+   *
+   * Every pattern sees every character, even once an earlier slot has
+   * matched, so the others are still in step if feeding carries on.
+   *
+   * @param c The received character
+   * @return *uint8_t* The 1-based slot of the first pattern the data now ends
+   * with, or 0 if there is no match
+   */
+  uint8_t feed(char c) {
+    uint8_t res = 0;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (!_len[i]) continue;
+      _state[i] = next(i, c);
+      if (_state[i] == _len[i] && !res) res = i + 1;
+    }
+    return res;
+  }
+
+  /**
+   * @brief The smallest number of characters that must still be fed before any
+   * pattern could match
+   */
+  uint8_t minRemaining() {
+    uint8_t res = 0xFF;
+    for (uint8_t i = 0; i < _count; i++) {
+      if (!_len[i]) continue;
+      // a completed (but not restarted) pattern can match again after one
+      // character at the earliest
+      uint8_t r = _state[i] < _len[i] ? _len[i] - _state[i] : 1;
+      if (r < res) res = r;
+    }
+    return res;
+  }
+
+ private:
+  char at(uint8_t i, uint8_t pos) {
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+    return pgm_read_byte(reinterpret_cast<const char*>(_p[i]) + pos);
+#else
+    return _p[i][pos];
+#endif
+  }
+
+  static uint8_t strLen(GsmConstStr p) {
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+    return strlen_P(reinterpret_cast<const char*>(p));
+#else
+    return strlen(p);
+#endif
+  }
+
+  // The next state of pattern i after receiving c
+  uint8_t next(uint8_t i, char c) {
+    uint8_t s = _state[i];
+    if (s < _len[i] && at(i, s) == c) return s + 1;
+    // Find the longest prefix ending in c whose first k - 1 characters are a
+    // border of the part we had matched so far
+    for (uint8_t k = s; k > 0; k--) {
+      if (at(i, k - 1) != c) continue;
+      uint8_t j = 0;
+      while (j < k - 1 && at(i, j) == at(i, s - k + 1 + j)) j++;
+      if (j == k - 1) return k;
+    }
+    return 0;
+  }
+
+  GsmConstStr _p[N];      /// The patterns
+  uint8_t     _len[N];    /// The length of each pattern
+  uint8_t     _state[N];  /// The number of characters matched per pattern
+  uint8_t     _count;     /// The number of slots in use
+};
+
+#endif  // SRC_TINYGSMMATCHER_H_
@@ -10,6 +10,9 @@
 #define SRC_TINYGSMMODEM_H_
 
 #include "TinyGsmCommon.h"
+#include "TinyGsmMatcher.h"
+#include "TinyGsmLineBuffer.h"
+#include "TinyGsmCommandBuffer.h"
 
 #ifndef AT_NL
 #define AT_NL "\r\n"
@@ -23,7 +26,6 @@
 #define AT_ERROR "ERROR"
 #endif
 
-#if defined TINY_GSM_DEBUG
 #ifndef AT_VERBOSE
 #define AT_VERBOSE "+CME ERROR:"
 #endif
@@ -31,6 +33,43 @@
 #ifndef AT_VERBOSE_2
 #define AT_VERBOSE_2 "+CMS ERROR:"
 #endif
+
+// The size of the buffer holding the tail of a response for URC handlers
+#ifndef TINY_GSM_RESPONSE_BUFFER
+#define TINY_GSM_RESPONSE_BUFFER 64
+#endif
+
+// The most URC handlers a modem may ask waitResponse to watch for
+#ifndef TINY_GSM_MAX_URCS
+#define TINY_GSM_MAX_URCS 10
+#endif
+
+// The most URC callbacks the application may add with registerURC
+#ifndef TINY_GSM_MAX_URC_HOOKS
+#define TINY_GSM_MAX_URC_HOOKS 4
+#endif
+
+// The size of the buffer an AT command is assembled in before it is sent
+#ifndef TINY_GSM_AT_BUFFER
+#define TINY_GSM_AT_BUFFER 64
+#endif
+
+// With TINY_GSM_ASYNC_COMMANDS defined, the number of AT commands that can be
+// queued with submitAT, and the space for each one
+#ifndef TINY_GSM_ASYNC_QUEUE
+#define TINY_GSM_ASYNC_QUEUE 4
+#endif
+
+#ifndef TINY_GSM_ASYNC_CMD_LEN
+#define TINY_GSM_ASYNC_CMD_LEN 48
+#endif
+
+// Define TINY_GSM_NUMERIC_RESULTS to have the modem switched to numeric result
+// codes (ATV0) at init; "0\r" is a lot less to send and match than
+// "\r\nOK\r\n". A numeric code at the very start of a wait is only taken as
+// final once this many milliseconds have passed without a new line after it.
+#ifndef TINY_GSM_NUMERIC_GRACE
+#define TINY_GSM_NUMERIC_GRACE 2
 #endif
 
 #ifndef MODEM_MANUFACTURER
@@ -44,10 +83,119 @@
 static const char GSM_OK[] TINY_GSM_PROGMEM    = AT_OK AT_NL;
 static const char GSM_ERROR[] TINY_GSM_PROGMEM = AT_ERROR AT_NL;
 
-#if defined       TINY_GSM_DEBUG
+/**
+ * @brief How a modem holds on to incoming socket data
+ */
+enum TinyGsmBufferMode {
+  // For modules that do not store incoming data in any sort of buffer
+  GSM_NO_MODEM_BUFFER,
+  // Data is stored in a buffer, but we can only read from the buffer, not
+  // check how much data is stored in it
+  GSM_BUFFER_READ_NO_CHECK,
+  // Data is stored in a buffer and we can both read and check the size of the
+  // buffer
+  GSM_BUFFER_READ_AND_CHECK_SIZE,
+};
+
+// An empty type for each buffer mode, used to pick the matching
+// implementation by overloading
+template <TinyGsmBufferMode mode>
+struct TinyGsmBufferTag {};
+
+/**
+ * @brief The compile-time properties of a modem.
+ *
+ * Each driver specializes this with TINY_GSM_MODEM_TRAITS, right before the
+ * modem class. The templates read the buffer mode, line ending and so on from
+ * here rather than from global macros, so each modem type gets its own and
+ * several can be used in one program.
+ */
+template <class modemType>
+struct TinyGsmModemTraits;
+
+/**
+ * @brief Declare the traits of a modem class
+ *
+ * Expand this once in the driver, after TINY_GSM_MUX_COUNT, AT_NL,
+ * MODEM_MANUFACTURER and MODEM_MODEL are set and the templates are included.
+ *
+ * @param modem The modem class
+ * @param mode The TinyGsmBufferMode of the modem
+ * @param send The most bytes the modem accepts in one send command
+ * @param recv The most bytes the modem returns from one read command; 0 if it
+ * does not buffer incoming data
+ */
+#define TINY_GSM_MODEM_TRAITS(modem, mode, send, recv)                  \
+  class modem;                                                          \
+  template <>                                                           \
+  struct TinyGsmModemTraits<modem> {                                    \
+    static constexpr TinyGsmBufferMode bufferMode = mode;               \
+    static constexpr uint8_t           muxCount   = TINY_GSM_MUX_COUNT; \
+    static constexpr uint16_t          rxBuffer   = TINY_GSM_RX_BUFFER; \
+    static constexpr uint16_t          maxSend    = send;               \
+    static constexpr uint16_t          maxRecv    = recv;               \
+    static const char*                 nl() {                           \
+      return AT_NL;                                                     \
+    }                                                                   \
+    static GsmConstStr ok() {                                           \
+      return GF(AT_OK AT_NL);                                           \
+    }                                                                   \
+    static GsmConstStr error() {                                        \
+      return GF(AT_ERROR AT_NL);                                        \
+    }                                                                   \
+    static const char* manufacturer() {                                 \
+      return MODEM_MANUFACTURER;                                        \
+    }                                                                   \
+    static const char* model() {                                        \
+      return MODEM_MODEL;                                               \
+    }                                                                   \
+  };
+
+typedef TinyGsmLineBuffer<TINY_GSM_RESPONSE_BUFFER> GsmLineBuffer;
+
+/**
+ * @brief An entry in a modem's table of URC handlers.
+ *
+ * The handler is called from waitResponse as soon as the prefix has been
+ * received. It reads whatever follows the prefix from the stream and returns
+ * true if it dealt with the URC.
+ */
+template <class modemType>
+struct TinyGsmUrcHandler {
+  GsmConstStr prefix;
+  bool (modemType::*handler)(GsmLineBuffer& data);
+};
+
+/**
+ * @brief A URC callback registered by the application.
+ *
+ * @param stream The modem stream, positioned just after the URC prefix
+ * @param arg The argument given to registerURC
+ */
+typedef void (*GsmUrcCallback)(Stream& stream, void* arg);
+
+#if defined TINY_GSM_ASYNC_COMMANDS
+/**
+ * @brief A handle for a command queued with submitAT; never 0 for a valid
+ * command.
+ */
+typedef uint8_t GsmCommandHandle;
+
+/**
+ * @brief Called from poll() once a queued command has finished.
+ *
+ * @param handle The handle submitAT returned for the command
+ * @param result 1 for OK, 2 for ERROR, 0 for a time-out
+ * @param response The tail of the response, up to TINY_GSM_RESPONSE_BUFFER
+ * characters
+ * @param arg The argument given to submitAT
+ */
+typedef void (*GsmCommandCallback)(GsmCommandHandle handle, int8_t result,
+                                   const char* response, void* arg);
+#endif
+
 static const char GSM_VERBOSE[] TINY_GSM_PROGMEM   = AT_VERBOSE;
 static const char GSM_VERBOSE_2[] TINY_GSM_PROGMEM = AT_VERBOSE_2;
-#endif
 
 template <class modemType>
 class TinyGsmModem {
@@ -84,13 +232,28 @@ class TinyGsmModem {
   /**
    * @brief Recursive variadic template to send AT commands
    *
+   * The command is assembled in a TINY_GSM_AT_BUFFER sized buffer and written
+   * to the stream in one go. Define TINY_GSM_NO_AT_FLUSH to skip flushing the
+   * stream after each command.
+   *
    * @tparam Args
    * @param cmd The commands to send
    */
   template <typename... Args>
   inline void sendAT(Args... cmd) {
-    thisModem().streamWrite("AT", cmd..., AT_NL);
+#if defined TINY_GSM_ASYNC_COMMANDS
+    finishCurrentCommand();
+#endif
+    lastErrorCode = -1;
+    TinyGsmCommandBuffer<TINY_GSM_AT_BUFFER> buf(thisModem().stream);
+    buf.add("AT", cmd..., ModemTraits::nl());
+    buf.send();
+#if !defined(TINY_GSM_NO_AT_FLUSH)
     thisModem().stream.flush();
+#endif
+#if defined TINY_GSM_NUMERIC_RESULTS
+    responseStart = true;
+#endif
     TINY_GSM_YIELD(); /* DBG("### AT:", cmd...); */
   }
 
@@ -118,6 +281,189 @@ class TinyGsmModem {
     return thisModem().testATImpl(timeout_ms);
   }
 
+  /**
+   * @brief Get the code of the +CME ERROR or +CMS ERROR the last command
+   * failed with
+   *
+   * waitResponse stops as soon as the modem reports one of these, instead of
+   * running into its time-out, and returns 0. The drivers ask for numeric
+   * codes (AT+CMEE=1) at init; see 3GPP TS 27.007 section 9.2 for their
+   * meaning.
+   *
+   * @return *int16_t* The error code, or -1 if the last command sent did not
+   * fail with a numeric error code
+   */
+  int16_t lastError() {
+    return lastErrorCode;
+  }
+
+  /**
+   * @brief Register a callback for an unsolicited result code
+   *
+   * The callback is called from within waitResponse as soon as the prefix has
+   * been received, and should read the rest of the URC from the stream. URCs
+   * that the modem driver handles itself take precedence.
+   *
+   * @param prefix The URC prefix, such as GF("+CMTI:"); it must stay valid for
+   * as long as it is registered
+   * @param callback The function to call
+   * @param arg An argument handed back to the callback
+   * @return *true* The callback was registered
+   * @return *false* There is no room left; see TINY_GSM_MAX_URC_HOOKS
+   */
+  bool registerURC(GsmConstStr prefix, GsmUrcCallback callback,
+                   void* arg = nullptr) {
+    if (!prefix || !callback || urcHookCount >= TINY_GSM_MAX_URC_HOOKS) {
+      return false;
+    }
+    urcHooks[urcHookCount].prefix   = prefix;
+    urcHooks[urcHookCount].callback = callback;
+    urcHooks[urcHookCount].arg      = arg;
+    urcHookCount++;
+    return true;
+  }
+
+  /**
+   * @brief Remove a callback added with registerURC
+   *
+   * @param prefix The same prefix pointer that was registered
+   * @return *true* The callback was removed
+   * @return *false* Nothing was registered for that prefix
+   */
+  bool unregisterURC(GsmConstStr prefix) {
+    for (uint8_t i = 0; i < urcHookCount; i++) {
+      if (urcHooks[i].prefix != prefix) continue;
+      for (uint8_t j = i + 1; j < urcHookCount; j++) {
+        urcHooks[j - 1] = urcHooks[j];
+      }
+      urcHookCount--;
+      return true;
+    }
+    return false;
+  }
+
+#if defined TINY_GSM_ASYNC_COMMANDS
+  /**
+   * @brief Queue an AT command to be sent from poll() without waiting for its
+   * response
+   *
+   * Commands are sent one at a time, in the order they were queued. Any of the
+   * blocking functions may still be used in between; they first wait for the
+   * command in flight, if any, to finish.
+   *
+   * @param timeout_ms The time to wait for the response once it has been sent
+   * @param callback Called from poll() when the command has finished; may be
+   * nullptr, in which case the result is kept for commandResult()
+   * @param arg An argument handed back to the callback
+   * @param cmd The command, as for sendAT
+   * @return *GsmCommandHandle* A handle for the command, or 0 if the queue is
+   * full or the command does not fit in TINY_GSM_ASYNC_CMD_LEN
+   */
+  template <typename... Args>
+  GsmCommandHandle submitAT(uint32_t timeout_ms, GsmCommandCallback callback,
+                            void* arg, Args... cmd) {
+    for (uint8_t i = 0; i < TINY_GSM_ASYNC_QUEUE; i++) {
+      AsyncCommand& c = asyncQueue[i];
+      if (c.handle) continue;
+      c.cmd.clear();
+      c.cmd.add("AT", cmd..., ModemTraits::nl());
+      if (c.cmd.overflowed()) return 0;
+      if (++asyncLastHandle == 0) asyncLastHandle = 1;
+      c.handle     = asyncLastHandle;
+      c.timeout_ms = timeout_ms;
+      c.callback   = callback;
+      c.arg        = arg;
+      c.result     = -1;
+      return c.handle;
+    }
+    return 0;
+  }
+
+  /**
+   * @brief Advance the queued commands and handle any URCs, without blocking
+   *
+   * Call this often from the main loop while commands are queued.
+   */
+  void poll() {
+    if (asyncPolling) return;
+    asyncPolling = true;
+    if (asyncCurrent < 0) {
+      int8_t next = -1;
+      for (uint8_t i = 0; i < TINY_GSM_ASYNC_QUEUE; i++) {
+        AsyncCommand& c = asyncQueue[i];
+        if (!c.handle || c.result >= 0) continue;
+        // The queued command with the oldest handle goes first
+        if (next < 0 || static_cast<uint8_t>(asyncLastHandle - c.handle) >
+                            static_cast<uint8_t>(asyncLastHandle -
+                                                 asyncQueue[next].handle)) {
+          next = i;
+        }
+      }
+      if (next >= 0) {
+        asyncCurrent = next;
+        asyncQueue[next].cmd.sendTo(thisModem().stream);
+        lastErrorCode = -1;
+#if defined TINY_GSM_NUMERIC_RESULTS
+        responseStart = true;
+#endif
+        listenStart(asyncListener, nullptr);
+        asyncListening = false;
+        asyncStart     = millis();
+      }
+    }
+    if (asyncCurrent >= 0) {
+      AsyncCommand& c     = asyncQueue[asyncCurrent];
+      int8_t        index = listenPoll(asyncListener);
+      if (index >= 0 || millis() - asyncStart >= c.timeout_ms) {
+        asyncCurrent = -1;
+        c.result     = listenFinish(asyncListener, index);
+        if (c.callback) {
+          GsmCommandHandle handle = c.handle;
+          c.handle                = 0;
+          c.callback(handle, c.result, asyncListener.line.c_str(), c.arg);
+        }
+      }
+    } else if (thisModem().stream.available()) {
+      // Nothing in flight, so anything arriving can only be a URC
+      if (!asyncListening) {
+        listenStart(asyncListener, nullptr, nullptr, nullptr);
+        asyncListening = true;
+      }
+      listenPoll(asyncListener);
+    }
+    asyncPolling = false;
+  }
+
+  /**
+   * @brief Whether any queued commands have yet to finish
+   */
+  bool commandsPending() {
+    for (uint8_t i = 0; i < TINY_GSM_ASYNC_QUEUE; i++) {
+      if (asyncQueue[i].handle && asyncQueue[i].result < 0) return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Get the result of a command queued without a callback
+   *
+   * Once a finished command's result has been read, the handle is released.
+   *
+   * @param handle The handle submitAT returned
+   * @return *int8_t* -1 while the command is queued or in flight, otherwise 1
+   * for OK, 2 for ERROR or 0 for a time-out (or an unknown handle)
+   */
+  int8_t commandResult(GsmCommandHandle handle) {
+    for (uint8_t i = 0; handle && i < TINY_GSM_ASYNC_QUEUE; i++) {
+      AsyncCommand& c = asyncQueue[i];
+      if (c.handle != handle) continue;
+      if (c.result >= 0) c.handle = 0;
+      return c.result;
+    }
+    return 0;
+  }
+#endif
+
   /**
    * @brief Listen for responses to commands and handle URCs
    *
@@ -140,11 +486,12 @@ class TinyGsmModem {
    * @return *int8_t* the index of the response input
    */
   int8_t waitResponse(uint32_t timeout_ms, String& data,
-                      GsmConstStr r1 = GFP(GSM_OK),
-                      GsmConstStr r2 = GFP(GSM_ERROR), GsmConstStr r3 = nullptr,
-                      GsmConstStr r4 = nullptr, GsmConstStr r5 = nullptr,
-                      GsmConstStr r6 = nullptr, GsmConstStr r7 = nullptr) {
-    return thisModem().waitResponseImpl(timeout_ms, data, r1, r2, r3, r4, r5,
+                      GsmConstStr r1 = ModemTraits::ok(),
+                      GsmConstStr r2 = ModemTraits::error(),
+                      GsmConstStr r3 = nullptr, GsmConstStr r4 = nullptr,
+                      GsmConstStr r5 = nullptr, GsmConstStr r6 = nullptr,
+                      GsmConstStr r7 = nullptr) {
+    return thisModem().waitResponseImpl(timeout_ms, &data, r1, r2, r3, r4, r5,
                                         r6, r7);
   }
 
@@ -168,12 +515,13 @@ class TinyGsmModem {
    * of NULL
    * @return *int8_t* the index of the response input
    */
-  int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = GFP(GSM_OK),
-                      GsmConstStr r2 = GFP(GSM_ERROR), GsmConstStr r3 = nullptr,
-                      GsmConstStr r4 = nullptr, GsmConstStr r5 = nullptr,
-                      GsmConstStr r6 = nullptr, GsmConstStr r7 = nullptr) {
-    String data;
-    return waitResponse(timeout_ms, data, r1, r2, r3, r4, r5, r6, r7);
+  int8_t waitResponse(uint32_t timeout_ms, GsmConstStr r1 = ModemTraits::ok(),
+                      GsmConstStr r2 = ModemTraits::error(),
+                      GsmConstStr r3 = nullptr, GsmConstStr r4 = nullptr,
+                      GsmConstStr r5 = nullptr, GsmConstStr r6 = nullptr,
+                      GsmConstStr r7 = nullptr) {
+    return thisModem().waitResponseImpl(timeout_ms, nullptr, r1, r2, r3, r4,
+                                        r5, r6, r7);
   }
 
   /**
@@ -196,10 +544,11 @@ class TinyGsmModem {
    * of NULL
    * @return *int8_t* the index of the response input
    */
-  int8_t waitResponse(GsmConstStr r1 = GFP(GSM_OK),
-                      GsmConstStr r2 = GFP(GSM_ERROR), GsmConstStr r3 = nullptr,
-                      GsmConstStr r4 = nullptr, GsmConstStr r5 = nullptr,
-                      GsmConstStr r6 = nullptr, GsmConstStr r7 = nullptr) {
+  int8_t waitResponse(GsmConstStr r1 = ModemTraits::ok(),
+                      GsmConstStr r2 = ModemTraits::error(),
+                      GsmConstStr r3 = nullptr, GsmConstStr r4 = nullptr,
+                      GsmConstStr r5 = nullptr, GsmConstStr r6 = nullptr,
+                      GsmConstStr r7 = nullptr) {
     return waitResponse(1000L, r1, r2, r3, r4, r5, r6, r7);
   }
 
@@ -421,6 +770,34 @@ class TinyGsmModem {
     return static_cast<modemType&>(*this);
   }
   /**@}*/
+
+  // The compile-time properties of the modem
+  typedef TinyGsmModemTraits<modemType> ModemTraits;
+#if defined TINY_GSM_ASYNC_COMMANDS
+  TinyGsmModem()
+      : urcHookCount(0),
+        lastErrorCode(-1),
+        asyncCurrent(-1),
+        asyncLastHandle(0),
+        asyncPolling(false),
+        asyncListening(false) {
+    for (uint8_t i = 0; i < TINY_GSM_ASYNC_QUEUE; i++) {
+      asyncQueue[i].handle = 0;
+    }
+#if defined TINY_GSM_NUMERIC_RESULTS
+    numericResults = false;
+    responseStart  = false;
+#endif
+  }
+#elif defined TINY_GSM_NUMERIC_RESULTS
+  TinyGsmModem()
+      : urcHookCount(0),
+        lastErrorCode(-1),
+        numericResults(false),
+        responseStart(false) {}
+#else
+  TinyGsmModem() : urcHookCount(0), lastErrorCode(-1) {}
+#endif
   ~TinyGsmModem() {}
 
 
@@ -531,6 +908,12 @@ class TinyGsmModem {
   }
 
   inline void cleanResponseString(String& res) {
+#if defined TINY_GSM_NUMERIC_RESULTS
+    // A numeric OK ends the response without a new line
+    if (res.endsWith("\n0\r") || res == "0\r") {
+      res.remove(res.length() - 2);
+    }
+#endif
     // Do the replaces twice so we cover both \r and \r\n type endings
     res.replace("\r\nOK\r\n", "");
     res.replace("\rOK\r", "");
@@ -581,20 +964,141 @@ class TinyGsmModem {
   bool testATImpl(uint32_t timeout_ms = 10000L) {
     for (uint32_t start = millis(); millis() - start < timeout_ms;) {
       thisModem().sendAT(GF(""));
+#if defined TINY_GSM_NUMERIC_RESULTS
+      // The modem may have been reset to verbose results, or kept numeric
+      // ones while we were reset, so accept either and follow along
+      numericResults = false;
+      int8_t res     = thisModem().waitResponse(200L, ModemTraits::ok(),
+                                                ModemTraits::error(),
+                                                GF("0\r"));
+      if (res == 1 || res == 3) {
+        numericResults = res == 3;
+        return true;
+      }
+#else
       if (thisModem().waitResponse(200) == 1) { return true; }
+#endif
       delay(100);
     }
     return false;
   }
 
-  // TODO(vshymanskyy): Optimize this!
-  int8_t waitResponseImpl(uint32_t timeout_ms, String& data,
-                          GsmConstStr r1 = GFP(GSM_OK),
-                          GsmConstStr r2 = GFP(GSM_ERROR),
+#if defined TINY_GSM_NUMERIC_RESULTS
+  // Switch the modem to numeric result codes; called by the drivers at init.
+  // Until it succeeds, verbose results are expected.
+  bool enableNumericResults() {
+    thisModem().sendAT(GF("V0"));
+    numericResults = thisModem().waitResponse(GF("0\r"), ModemTraits::ok(),
+                                              ModemTraits::error()) == 1;
+    return numericResults;
+  }
+
+  // The numeric code for a final result given in verbose form, with or without
+  // the surrounding line endings, or nullptr if it does not have one
+  static GsmConstStr numericResult(GsmConstStr r) {
+    if (!r) return nullptr;
+    if (isResult(r, GF(AT_OK))) return GF("0\r");
+    if (isResult(r, GF(AT_ERROR))) return GF("4\r");
+    if (isResult(r, GF("CONNECT"))) return GF("1\r");
+    if (isResult(r, GF("NO CARRIER"))) return GF("3\r");
+    if (isResult(r, GF("NO DIALTONE"))) return GF("6\r");
+    if (isResult(r, GF("BUSY"))) return GF("7\r");
+    if (isResult(r, GF("NO ANSWER"))) return GF("8\r");
+    return nullptr;
+  }
+
+  static char progChar(GsmConstStr s, uint8_t pos) {
+#if defined(__AVR__) && !defined(__AVR_ATmega4809__)
+    return pgm_read_byte(reinterpret_cast<const char*>(s) + pos);
+#else
+    return s[pos];
+#endif
+  }
+
+  // Whether r is the result code name, give or take line endings
+  static bool isResult(GsmConstStr r, GsmConstStr name) {
+    uint8_t i = 0;
+    while (progChar(r, i) == '\r' || progChar(r, i) == '\n') i++;
+    for (uint8_t j = 0; progChar(name, j); i++, j++) {
+      if (progChar(r, i) != progChar(name, j)) return false;
+    }
+    while (progChar(r, i) == '\r' || progChar(r, i) == '\n') i++;
+    return !progChar(r, i);
+  }
+#endif
+
+  // The expected responses, any verbose error messages and the modem's URC
+  // prefixes are all tracked by one incremental matcher, so each received
+  // character is only compared once per pattern, and a matched URC prefix goes
+  // straight to its handler by index.
+  // The tail of the response is kept in a fixed-size line buffer for the URC
+  // handlers; it is only copied into a String if the caller asked for one.
+  int8_t waitResponseImpl(uint32_t timeout_ms, String* data,
+                          GsmConstStr r1 = ModemTraits::ok(),
+                          GsmConstStr r2 = ModemTraits::error(),
                           GsmConstStr r3 = nullptr, GsmConstStr r4 = nullptr,
                           GsmConstStr r5 = nullptr, GsmConstStr r6 = nullptr,
                           GsmConstStr r7 = nullptr) {
-    data.reserve(64);
+#if defined TINY_GSM_ASYNC_COMMANDS
+    finishCurrentCommand();
+#endif
+    ResponseListener listener;
+    listenStart(listener, data, r1, r2, r3, r4, r5, r6, r7);
+    int8_t   index       = -1;
+    uint32_t startMillis = millis();
+    do {
+      TINY_GSM_YIELD();
+      index = listenPoll(listener);
+    } while (index < 0 && millis() - startMillis < timeout_ms);
+    return listenFinish(listener, index);
+  }
+
+#if defined TINY_GSM_ASYNC_COMMANDS
+  // Wait for the queued command in flight, if any, so a blocking command does
+  // not get mixed up with its response
+  void finishCurrentCommand() {
+    if (asyncPolling) return;
+    asyncListening = false;
+    while (asyncCurrent >= 0) {
+      TINY_GSM_YIELD();
+      poll();
+    }
+  }
+#endif
+
+  // Everything waitResponse needs to remember while listening for a response,
+  // so that the same listener can also be advanced a bit at a time
+  struct ResponseListener {
+#if defined TINY_GSM_NUMERIC_RESULTS
+    TinyGsmMatcher<16 + TINY_GSM_MAX_URCS + TINY_GSM_MAX_URC_HOOKS> matcher;
+#else
+    TinyGsmMatcher<9 + TINY_GSM_MAX_URCS + TINY_GSM_MAX_URC_HOOKS> matcher;
+#endif
+    uint8_t lastVerbose;
+#if defined TINY_GSM_NUMERIC_RESULTS
+    uint8_t  lastHook;
+    uint8_t  numericFor[7];  // The response each numeric code stands for
+    uint8_t  primed;         // A response satisfied before anything arrived
+    uint8_t  pending;        // A numeric code waiting to be confirmed
+    uint32_t pendingSince;
+    bool     lineStart;      // Whether the line buffer starts a new line
+#endif
+    GsmLineBuffer                       line;
+    String*                             data;
+    const TinyGsmUrcHandler<modemType>* handlers;
+    uint8_t                             lastResponse;
+    uint8_t                             firstHandler;
+    uint8_t                             lastHandler;
+  };
+
+  // Set up a listener for the given responses and the modem's URCs
+  void listenStart(ResponseListener& l, String* data,
+                   GsmConstStr r1 = ModemTraits::ok(),
+                   GsmConstStr r2 = ModemTraits::error(),
+                   GsmConstStr r3 = nullptr, GsmConstStr r4 = nullptr,
+                   GsmConstStr r5 = nullptr, GsmConstStr r6 = nullptr,
+                   GsmConstStr r7 = nullptr) {
+    if (data) { data->reserve(64); }
 
 #ifdef TINY_GSM_DEBUG_DEEP
     DBG(GF("r1 <"), r1 ? r1 : GF("NULL"), GF("> r2 <"), r2 ? r2 : GF("NULL"),
@@ -602,76 +1106,226 @@ class TinyGsmModem {
         GF("> r5 <"), r5 ? r5 : GF("NULL"), GF("> r6 <"), r6 ? r6 : GF("NULL"),
         GF("> r7 <"), r7 ? r7 : GF("NULL"), '>');
 #endif
-    uint8_t  index       = 0;
-    uint32_t startMillis = millis();
-    do {
-      TINY_GSM_YIELD();
-      while (thisModem().stream.available() > 0) {
-        TINY_GSM_YIELD();
-        int8_t a = thisModem().stream.read();
+#if defined TINY_GSM_NUMERIC_RESULTS
+    l.primed      = 0;
+    l.pending     = 0;
+    l.lineStart   = responseStart;
+    responseStart = false;
+#endif
+    l.matcher.clear();
+    listenAdd(l, r1);
+    listenAdd(l, r2);
+    listenAdd(l, r3);
+    listenAdd(l, r4);
+    listenAdd(l, r5);
+    listenAdd(l, r6);
+    l.lastResponse = listenAdd(l, r7);
+    l.matcher.add(GFP(GSM_VERBOSE));
+    l.lastVerbose = l.matcher.add(GFP(GSM_VERBOSE_2));
+    l.handlers     = thisModem().urcHandlers();
+    l.firstHandler = l.matcher.size() + 1;
+    l.lastHandler  = l.matcher.size();
+    for (uint8_t i = 0; l.handlers && i < TINY_GSM_MAX_URCS; i++) {
+      if (!l.handlers[i].prefix) break;
+      l.lastHandler = listenAdd(l, l.handlers[i].prefix);
+    }
+    for (uint8_t i = 0; i < urcHookCount; i++) {
+      listenAdd(l, urcHooks[i].prefix);
+    }
+#if defined TINY_GSM_NUMERIC_RESULTS
+    // Listen for the numeric form of the final results as well; the verbose
+    // form still works if the modem has been reset behind our back
+    const GsmConstStr r[7] = {r1, r2, r3, r4, r5, r6, r7};
+    uint8_t           alias = 0;
+    l.lastHook              = l.matcher.size();
+    for (uint8_t i = 0; numericResults && i < 7; i++) {
+      GsmConstStr numeric = numericResult(r[i]);
+      if (!numeric) continue;
+      l.matcher.add(numeric);
+      l.numericFor[alias++] = i + 1;
+    }
+#endif
+    l.line.clear();
+    l.data = data;
+  }
+
+  // Add a pattern to a listener, returning its slot
+  uint8_t listenAdd(ResponseListener& l, GsmConstStr p) {
+#if defined TINY_GSM_NUMERIC_RESULTS
+    if (numericResults && p) {
+      // With numeric results, information text and URCs come without the line
+      // ending in front of them, so leave that out of the pattern
+      uint8_t skip = 0;
+      while (progChar(p, skip) == '\r' || progChar(p, skip) == '\n') skip++;
+      if (!progChar(p, skip)) {
+        // Nothing but a line ending, which at the start of a response has
+        // already been had
+        if (!l.lineStart) return l.matcher.add(p);
+        uint8_t slot = l.matcher.add(nullptr);
+        if (!l.primed) l.primed = slot;
+        return slot;
+      }
+      p = reinterpret_cast<GsmConstStr>(reinterpret_cast<const char*>(p) +
+                                        skip);
+    }
+#endif
+    return l.matcher.add(p);
+  }
+
+  // Read the code after a +CME ERROR or +CMS ERROR, up to the end of the line
+  void listenError(ResponseListener& l, uint8_t match) {
+    char   code[8];
+    size_t len = thisModem().stream.readBytesUntil('\r', code,
+                                                   sizeof(code) - 1);
+    code[len]  = '\0';
+    if (len == sizeof(code) - 1) {
+      // Not a code we could use; throw the rest away
+      thisModem().streamSkipUntil('\r');
+    }
+    if (thisModem().stream.peek() == '\n') { thisModem().stream.read(); }
+    char* start = code;
+    while (*start == ' ') start++;
+    lastErrorCode = *start >= '0' && *start <= '9' ? atoi(start) : -1;
+    DBG(GF("###"),
+        match < l.lastVerbose ? GFP(GSM_VERBOSE) : GFP(GSM_VERBOSE_2), code);
+#ifndef TINY_GSM_DEBUG
+    (void)match;  // only reported in debug builds
+#endif
+    l.line.clear();
+    if (l.data) { *l.data = ""; }
+  }
+
+  // Forget what has been received so far, after a URC has been dealt with
+  void listenRestart(ResponseListener& l) {
+    l.line.clear();
+    if (l.data) { *l.data = ""; }
+    l.matcher.restart();
+#if defined TINY_GSM_NUMERIC_RESULTS
+    l.lineStart = true;
+#endif
+  }
+
+#if defined TINY_GSM_NUMERIC_RESULTS
+  // Decide whether a numeric code that has just been matched is really the
+  // final result. Returns the index of the response, or -1 to keep listening.
+  int8_t listenNumeric(ResponseListener& l, uint8_t response) {
+    uint16_t len = l.line.length();
+    // Part way into what we have read, it has to start a line
+    if (len > 2) return l.line.c_str()[len - 3] == '\n' ? response : -1;
+    if (l.lineStart) return response;
+    // Right at the start of a wait, it could also be the end of an
+    // information line the caller has read part of; that would be followed by
+    // a new line, so give it a moment to show up
+    l.pending      = response;
+    l.pendingSince = millis();
+    return listenPending(l);
+  }
+
+  int8_t listenPending(ResponseListener& l) {
+    if (thisModem().stream.available()) {
+      if (thisModem().stream.peek() != '\n') return l.pending;
+      l.pending = 0;
+      return -1;
+    }
+    if (millis() - l.pendingSince >= TINY_GSM_NUMERIC_GRACE) return l.pending;
+    return -1;
+  }
+#endif
+
+  // Process whatever the modem has sent so far, without waiting for more.
+  // Returns the index of the matched response, 0 if the modem reported an
+  // error, or -1 if the response is not complete yet.
+  int8_t listenPoll(ResponseListener& l) {
+#if defined TINY_GSM_NUMERIC_RESULTS
+    if (l.primed) { return l.primed; }
+    if (l.pending) {
+      int8_t res = listenPending(l);
+      if (res >= 0 || l.pending) { return res; }
+    }
+#endif
+    int avail;
+    while ((avail = thisModem().stream.available()) > 0) {
+      // Read a block at a time, but never past the earliest point where any
+      // pattern could complete; callers and URC handlers go on to parse
+      // whatever follows a match straight from the stream.
+      char   chunk[16];
+      size_t len = TinyGsmMin(static_cast<size_t>(avail), sizeof(chunk));
+      len = TinyGsmMin(len, static_cast<size_t>(l.matcher.minRemaining()));
+      len = thisModem().stream.readBytes(chunk, len);
+      for (size_t i = 0; i < len; i++) {
+        int8_t a = chunk[i];
         if (a <= 0) continue;  // Skip 0x00 bytes, just in case
-        data += static_cast<char>(a);
-        if (r1 && data.endsWith(r1)) {
-          index = 1;
-          goto finish;
-        } else if (r2 && data.endsWith(r2)) {
-          index = 2;
-          goto finish;
-        } else if (r3 && data.endsWith(r3)) {
-          index = 3;
-          goto finish;
-        } else if (r4 && data.endsWith(r4)) {
-          index = 4;
-          goto finish;
-        } else if (r5 && data.endsWith(r5)) {
-          index = 5;
-          goto finish;
-        } else if (r6 && data.endsWith(r6)) {
-          index = 6;
-          goto finish;
-        } else if (r7 && data.endsWith(r7)) {
-          index = 7;
-          goto finish;
+        l.line += static_cast<char>(a);
+        if (l.data) { *l.data += static_cast<char>(a); }
+        uint8_t match = l.matcher.feed(a);
+        if (!match) { continue; }
+        if (match <= l.lastResponse) { return match; }
+        else if (match <= l.lastVerbose) {
+          // The command failed; keep the error code for lastError()
+          listenError(l, match);
+          return 0;
         }
-#if defined TINY_GSM_DEBUG
-        else if (data.endsWith(GFP(GSM_VERBOSE)) ||
-                 data.endsWith(GFP(GSM_VERBOSE_2))) {
-          // check how long the new line is
-          // should be either 1 ('\r' or '\n') or 2 ("\r\n"))
-          int len_atnl = strnlen(AT_NL, 3);
-          // Read out the verbose message, until the last character of the new
-          // line
-          data += thisModem().stream.readStringUntil(AT_NL[len_atnl]);
-#ifdef TINY_GSM_DEBUG_DEEP
-          data.trim();
-          DBG(GF("Verbose details <<<"), data, GF(">>>"));
-#endif
-          data = "";
-          goto finish;
+        else if (match <= l.lastHandler) {
+          // Dispatch straight to the handler for the matched prefix
+          const TinyGsmUrcHandler<modemType>& urc =
+              l.handlers[match - l.firstHandler];
+          if ((thisModem().*(urc.handler))(l.line)) { listenRestart(l); }
+        }
+#if defined TINY_GSM_NUMERIC_RESULTS
+        else if (match > l.lastHook) {
+          int8_t res = listenNumeric(l, l.numericFor[match - l.lastHook - 1]);
+          if (res >= 0 || l.pending) { return res; }
         }
 #endif
-        else if (thisModem().handleURCs(data)) {
-          data = "";
+        else {
+          const UrcHook& hook = urcHooks[match - l.lastHandler - 1];
+          hook.callback(thisModem().stream, hook.arg);
+          listenRestart(l);
         }
       }
-    } while (millis() - startMillis < timeout_ms);
-  finish:
-#ifdef TINY_GSM_DEBUG_DEEP
-    data.replace("\r", "←");
-    data.replace("\n", "↓");
-#endif
-    if (!index) {
-      data.trim();
-      if (data.length()) { DBG("### Unhandled:", data); }
-      data = "";
-    } else {
-#ifdef TINY_GSM_DEBUG_DEEP
-      DBG('<', index, '>', data);
+      TINY_GSM_YIELD();
+    }
+    return -1;
+  }
+
+  // Wrap up after listenPoll has returned index, or the wait has timed out
+  // with index still at -1
+  int8_t listenFinish(ResponseListener& l, int8_t index) {
+#if defined TINY_GSM_NUMERIC_RESULTS
+    if (index < 0 && l.pending) { index = l.pending; }
 #endif
+    if (index <= 0) {
+#ifdef TINY_GSM_DEBUG
+      if (index < 0) {
+        String unhandled = l.line.c_str();
+        unhandled.trim();
+        if (unhandled.length()) { DBG("### Unhandled:", unhandled); }
+      }
+#endif
+      if (l.data) { *l.data = ""; }
+      return 0;
     }
+#ifdef TINY_GSM_DEBUG_DEEP
+    String res = l.line.c_str();
+    res.replace("\r", "←");
+    res.replace("\n", "↓");
+    DBG('<', index, '>', res);
+#endif
     return index;
   }
 
+  // The modem's table of URC handlers, ending with an entry with a nullptr
+  // prefix, or nullptr if the modem has no URCs to handle
+  const TinyGsmUrcHandler<modemType>* urcHandlers() {
+    return nullptr;
+  }
+
+  // Handler for URCs that only announce something we don't keep track of
+  bool handleIgnoredURC(GsmLineBuffer&) {
+    thisModem().streamSkipUntil('\n');
+    DBG("### Network information updated.");
+    return true;
+  }
 
   String getModemInfoImpl() {
     thisModem().sendAT(GF("I"));  // 3GPP TS 27.007
@@ -691,7 +1345,7 @@ class TinyGsmModem {
 
   // Gets the modem manufacturer
   String getModemManufacturerImpl() {
-    String manufacturer = MODEM_MANUFACTURER;
+    String manufacturer = ModemTraits::manufacturer();
     thisModem().sendAT(GF("+CGMI"));  // 3GPP TS 27.007 standard
     String res;
     if (thisModem().waitResponse(1000L, res) != 1) { return manufacturer; }
@@ -701,7 +1355,7 @@ class TinyGsmModem {
 
   // Gets the modem hardware version
   String getModemModelImpl() {
-    String model = MODEM_MODEL;
+    String model = ModemTraits::model();
     thisModem().sendAT(GF("+CGMM"));  // 3GPP TS 27.007 standard
     String res;
     if (thisModem().waitResponse(1000L, res) != 1) { return model; }
@@ -798,6 +1452,52 @@ class TinyGsmModem {
     if (thisModem().waitResponse() != 1) { return ""; }
     return res;
   }
+
+  /*
+   * URC callbacks registered by the application
+   */
+ protected:
+  struct UrcHook {
+    GsmConstStr    prefix;
+    GsmUrcCallback callback;
+    void*          arg;
+  };
+
+  UrcHook urcHooks[TINY_GSM_MAX_URC_HOOKS];
+  uint8_t urcHookCount;
+
+  // The code from the last +CME ERROR or +CMS ERROR, or -1
+  int16_t lastErrorCode;
+
+#if defined TINY_GSM_NUMERIC_RESULTS
+  // Whether the modem has been switched to numeric result codes
+  bool numericResults;
+  // Whether a command has been sent that nothing has listened for yet
+  bool responseStart;
+#endif
+
+#if defined TINY_GSM_ASYNC_COMMANDS
+  /*
+   * Commands queued with submitAT
+   */
+ protected:
+  struct AsyncCommand {
+    TinyGsmCommandBuffer<TINY_GSM_ASYNC_CMD_LEN> cmd;
+    uint32_t                                     timeout_ms;
+    GsmCommandCallback                           callback;
+    void*                                        arg;
+    GsmCommandHandle                             handle;  // 0 if free
+    int8_t                                       result;  // -1 until finished
+  };
+
+  AsyncCommand     asyncQueue[TINY_GSM_ASYNC_QUEUE];
+  ResponseListener asyncListener;
+  int8_t           asyncCurrent;  // The slot in flight, or -1
+  uint32_t         asyncStart;
+  GsmCommandHandle asyncLastHandle;
+  bool             asyncPolling;
+  bool             asyncListening;  // asyncListener is set up for URCs only
+#endif
 };
 
 #endif  // SRC_TINYGSMMODEM_H_
@@ -0,0 +1,358 @@
+/**
+ * @file       TinyGsmRxPool.h
+ * @author     Volodymyr Shymanskyy
+ * @license    LGPL-3.0
+ * @copyright  Copyright (c) 2016 Volodymyr Shymanskyy
+ * @date       Nov 2016
+ */
+
+#ifndef SRC_TINYGSMRXPOOL_H_
+#define SRC_TINYGSMRXPOOL_H_
+
+#include "TinyGsmFifo.h"
+
+/**
+ * @brief A fixed set of equal-sized blocks shared by the receive FIFOs of all
+ * of a modem's clients.
+ *
+ * Free blocks and the blocks of each FIFO are kept as chains through one array
+ * of next-block numbers, so the pool needs a single byte of bookkeeping per
+ * block. It is not meant to be used from an interrupt.
+ *
+ * @tparam Blocks The number of blocks, at most 254
+ * @tparam Size The size of each block, in bytes
+ */
+template <uint8_t Blocks, uint16_t Size>
+class TinyGsmRxPool {
+  static_assert(Blocks > 0 && Blocks < 0xFF,
+                "A TinyGsmRxPool holds between 1 and 254 blocks");
+  static_assert(static_cast<uint32_t>(Blocks) * Size <= 0xFFFF,
+                "A TinyGsmRxPool holds at most 65535 bytes");
+
+ public:
+  static const uint8_t NONE = 0xFF;  /// The number of no block
+
+  TinyGsmRxPool() : _free(0), _inUse(0), _highWater(0), _misses(0) {
+    for (uint8_t i = 0; i < Blocks; i++) { _next[i] = i + 1; }
+    _next[Blocks - 1] = NONE;
+  }
+
+  /**
+   * @brief Take a block out of the pool
+   *
+   * @return *uint8_t* The number of the block, or NONE if all are in use
+   */
+  uint8_t alloc() {
+    uint8_t b = _free;
+    if (b == NONE) {
+      _misses++;
+      return NONE;
+    }
+    _free    = _next[b];
+    _next[b] = NONE;
+    if (++_inUse > _highWater) _highWater = _inUse;
+    return b;
+  }
+
+  /**
+   * @brief Give a block back to the pool
+   */
+  void release(uint8_t b) {
+    _next[b] = _free;
+    _free    = b;
+    _inUse--;
+  }
+
+  uint8_t* data(uint8_t b) {
+    return _data[b];
+  }
+  uint8_t& next(uint8_t b) {
+    return _next[b];
+  }
+
+  static uint16_t blockSize() {
+    return Size;
+  }
+
+  /**
+   * @brief The number of blocks that are not in use
+   */
+  uint8_t available() const {
+    return Blocks - _inUse;
+  }
+
+  /**
+   * @brief The number of blocks holding data right now
+   */
+  uint8_t inUse() const {
+    return _inUse;
+  }
+
+  /**
+   * @brief The most blocks that have been in use at once
+   */
+  uint8_t highWater() const {
+    return _highWater;
+  }
+
+  /**
+   * @brief The number of times a block was wanted while none were free
+   */
+  uint16_t misses() const {
+    return _misses;
+  }
+
+  /**
+   * @brief Start the high-water mark and the miss count again from now
+   */
+  void resetStats() {
+    _highWater = _inUse;
+    _misses    = 0;
+  }
+
+ private:
+  uint8_t  _data[Blocks][Size];  /// The blocks
+  uint8_t  _next[Blocks];        /// The block after each one in its chain
+  uint8_t  _free;                /// The first free block
+  uint8_t  _inUse;               /// The number of blocks in use
+  uint8_t  _highWater;           /// The most blocks in use at once
+  uint16_t _misses;              /// The number of failed allocations
+};
+
+/**
+ * @brief A byte FIFO made of blocks borrowed from a TinyGsmRxPool.
+ *
+ * Has the same interface as the client's usual TinyGsmFifo, but takes a block
+ * from the pool only when the last one it holds is full and gives each one
+ * back as soon as it has been read, so the memory in use follows the data
+ * waiting to be read. It can be limited to a number of blocks, so that one busy
+ * FIFO can't leave the others with none. Unlike TinyGsmFifo it is not safe for
+ * one context to write while another reads.
+ *
+ * @tparam Pool The TinyGsmRxPool to borrow from
+ */
+template <class Pool>
+class TinyGsmPooledFifo {
+ public:
+  TinyGsmPooledFifo()
+      : _pool(nullptr),
+        _head(Pool::NONE),
+        _tail(Pool::NONE),
+        _blocks(0),
+        _cap(0),
+        _r(0),
+        _w(0),
+        _size(0) {}
+
+  // A copy starts out empty, borrowing from the same pool
+  TinyGsmPooledFifo(const TinyGsmPooledFifo& other)
+      : _pool(other._pool),
+        _head(Pool::NONE),
+        _tail(Pool::NONE),
+        _blocks(0),
+        _cap(other._cap),
+        _r(0),
+        _w(0),
+        _size(0) {}
+  TinyGsmPooledFifo& operator=(const TinyGsmPooledFifo& other) {
+    clear();
+    _pool = other._pool;
+    _cap  = other._cap;
+    return *this;
+  }
+
+  ~TinyGsmPooledFifo() {
+    clear();
+  }
+
+  /**
+   * @brief Set the pool to borrow from, emptying the FIFO
+   *
+   * @param pool The pool
+   * @param maxBlocks The most blocks the FIFO may hold at once
+   */
+  void setPool(Pool* pool, uint8_t maxBlocks) {
+    clear();
+    _pool = pool;
+    _cap  = maxBlocks;
+  }
+
+  Pool* pool() const {
+    return _pool;
+  }
+
+  /**
+   * @brief Empty the FIFO, giving all its blocks back to the pool
+   */
+  void clear() {
+    while (_head != Pool::NONE) {
+      uint8_t b = _head;
+      _head     = _pool->next(b);
+      _pool->release(b);
+    }
+    _tail   = Pool::NONE;
+    _blocks = 0;
+    _r      = 0;
+    _w    = 0;
+    _size = 0;
+  }
+
+  // writing API
+  //-------------------------------------------------------------
+
+  bool writeable(void) {
+    return free() > 0;
+  }
+
+  /**
+   * @brief The number of bytes that could be added right now: the rest of the
+   * last block plus as many free blocks from the pool as it may still take
+   */
+  int free(void) {
+    if (!_pool) return 0;
+    int     room   = _tail == Pool::NONE ? 0 : Pool::blockSize() - _w;
+    uint8_t blocks = _cap > _blocks ? _cap - _blocks : 0;
+    if (blocks > _pool->available()) blocks = _pool->available();
+    return room + static_cast<int>(blocks) * Pool::blockSize();
+  }
+
+  bool put(const uint8_t& c) {
+    int      n;
+    uint8_t* p = writableSpan(n);
+    if (!n) return false;
+    *p = c;
+    commit(1);
+    return true;
+  }
+
+  int put(const uint8_t* p, int n, bool = false) {
+    int c = n;
+    while (c) {
+      int      f;
+      uint8_t* w = writableSpan(f);
+      if (!f) break;
+      if (f > c) f = c;
+      TinyGsmFifoCopy(w, p, f);
+      commit(f);
+      p += f;
+      c -= f;
+    }
+    return n - c;
+  }
+
+  /**
+   * @brief Get the free space left in the last block, borrowing a new block
+   * first if that one is full
+   */
+  uint8_t* writableSpan(int& n) {
+    n = 0;
+    if (!_pool) return nullptr;
+    if (_tail == Pool::NONE || _w == Pool::blockSize()) {
+      if (_blocks >= _cap) return nullptr;
+      uint8_t b = _pool->alloc();
+      if (b == Pool::NONE) return nullptr;
+      _blocks++;
+      if (_tail == Pool::NONE) {
+        _head = b;
+        _r    = 0;
+      } else {
+        _pool->next(_tail) = b;
+      }
+      _tail = b;
+      _w    = 0;
+    }
+    n = Pool::blockSize() - _w;
+    return _pool->data(_tail) + _w;
+  }
+
+  void commit(int n) {
+    _w += n;
+    _size += n;
+  }
+
+  // reading API
+  // --------------------------------------------------------
+
+  bool readable(void) {
+    return _size > 0;
+  }
+
+  size_t size(void) {
+    return _size;
+  }
+
+  bool get(uint8_t* p) {
+    return get(p, 1) == 1;
+  }
+
+  int get(uint8_t* p, int n, bool = false) {
+    int c = n;
+    while (c) {
+      int            f;
+      const uint8_t* r = readableSpan(f);
+      if (!f) break;
+      if (f > c) f = c;
+      TinyGsmFifoCopy(p, r, f);
+      consume(f);
+      p += f;
+      c -= f;
+    }
+    return n - c;
+  }
+
+  /**
+   * @brief Get the unread bytes in the first block
+   */
+  const uint8_t* readableSpan(int& n) {
+    if (!_size) {
+      n = 0;
+      return nullptr;
+    }
+    n = (_head == _tail ? _w : Pool::blockSize()) - _r;
+    return _pool->data(_head) + _r;
+  }
+
+  /**
+   * @brief Drop bytes from the front, giving back each block that empties
+   *
+   * @param n The number of bytes to drop; no more than size()
+   */
+  void consume(int n) {
+    while (n > 0 && _size) {
+      int f;
+      readableSpan(f);
+      if (f > n) f = n;
+      _size -= f;
+      _r += f;
+      n -= f;
+      if (_r < (_head == _tail ? _w : Pool::blockSize())) break;
+      // the first block has all been read, so give it back
+      uint8_t b = _head;
+      if (_head == _tail) {
+        _head = _tail = Pool::NONE;
+        _w            = 0;
+      } else {
+        _head = _pool->next(b);
+      }
+      _pool->release(b);
+      _blocks--;
+      _r = 0;
+    }
+  }
+
+  uint8_t peek() {
+    return _size ? _pool->data(_head)[_r] : 0;
+  }
+
+ private:
+  Pool*    _pool;    /// The pool the blocks come from
+  uint8_t  _head;    /// The block being read
+  uint8_t  _tail;    /// The block being written
+  uint8_t  _blocks;  /// The number of blocks held
+  uint8_t  _cap;     /// The most blocks that may be held at once
+  uint16_t _r;       /// The read position in the head block
+  uint16_t _w;       /// The write position in the tail block
+  uint16_t _size;    /// The number of unread bytes
+};
+
+#endif  // SRC_TINYGSMRXPOOL_H_
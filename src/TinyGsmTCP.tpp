@@ -15,10 +15,68 @@
 
 #include "TinyGsmFifo.h"
 
+// The size of each client's built-in receive FIFO.  A client can be given a
+// buffer of its own instead, with setRxBuffer() or TinyGsmBufferedClient; set
+// this to 0 to leave the built-in one out when every client that needs a FIFO
+// gets its own.
 #if !defined(TINY_GSM_RX_BUFFER)
 #define TINY_GSM_RX_BUFFER 64
 #endif
 
+// With TINY_GSM_RX_POOL defined as a number of blocks, the clients' receive
+// FIFOs instead borrow blocks of TINY_GSM_RX_POOL_BLOCK bytes from a pool
+// shared by all the clients of the modem, as data arrives.  Each client may
+// hold up to TINY_GSM_RX_POOL_PER_SOCKET of them, half the pool by default,
+// so a busy socket can't leave the others with nowhere to put their data.
+#if defined TINY_GSM_RX_POOL
+#include "TinyGsmRxPool.h"
+#if !defined(TINY_GSM_RX_POOL_BLOCK)
+#define TINY_GSM_RX_POOL_BLOCK 64
+#endif
+#if !defined(TINY_GSM_RX_POOL_PER_SOCKET)
+#define TINY_GSM_RX_POOL_PER_SOCKET ((TINY_GSM_RX_POOL + 1) / 2)
+#endif
+#endif
+
+// With TINY_GSM_TX_BUFFER defined as a number of bytes, each client holds back
+// writes smaller than that and sends them together once the buffer fills, on
+// flush(), when the client is read from, or when the modem is maintained
+// TINY_GSM_TX_DELAY ms after the first of them.  setNoDelay(true) turns this
+// off for a single client.
+#if defined TINY_GSM_TX_BUFFER && !defined(TINY_GSM_TX_DELAY)
+#define TINY_GSM_TX_DELAY 20
+#endif
+
+// With TINY_GSM_SEND_WINDOW defined as a number of bytes, drivers that support
+// it return from a send as soon as the payload is out, rather than waiting for
+// the modem to acknowledge it.  The acknowledgements are picked up as URCs
+// during later commands or maintain(), and each socket may have up to that
+// many bytes waiting for one.  Up to TINY_GSM_SEND_QUEUE sends can be waiting
+// at once across all the sockets.
+#if defined TINY_GSM_SEND_WINDOW && !defined(TINY_GSM_SEND_QUEUE)
+#define TINY_GSM_SEND_QUEUE 4
+#endif
+
+// Some modules "forget" to notify about data arrival, so on those the modem is
+// asked about a socket with nothing known to be waiting whenever it is checked
+// and its poll interval has passed.  The interval starts at TINY_GSM_POLL_MIN
+// ms after any traffic and doubles after each poll that finds nothing, up to
+// TINY_GSM_POLL_MAX ms.  setPollInterval() changes both for a single client.
+#if !defined(TINY_GSM_POLL_MIN)
+#define TINY_GSM_POLL_MIN 100
+#endif
+#if !defined(TINY_GSM_POLL_MAX)
+#define TINY_GSM_POLL_MAX 4000
+#endif
+
+// On modems that have to be asked whether a socket is still open, connected()
+// only asks again once TINY_GSM_CONNECTED_TTL ms have passed since it last
+// did, and otherwise answers from what it was told then.  A socket closed by a
+// URC, or found closed, is reported closed straight away.  0 asks every time.
+#if !defined(TINY_GSM_CONNECTED_TTL)
+#define TINY_GSM_CONNECTED_TTL 1000
+#endif
+
 // Because of the ordering of resolution of overrides in templates, these need
 // to be written out every time.  This macro is to shorten that.
 #define TINY_GSM_CLIENT_CONNECT_OVERRIDES                             \
@@ -32,14 +90,9 @@
     return connect(ip, port, 75);                                     \
   }
 
-// // For modules that do not store incoming data in any sort of buffer
-// #define TINY_GSM_NO_MODEM_BUFFER
-// // Data is stored in a buffer, but we can only read from the buffer,
-// // not check how much data is stored in it
-// #define TINY_GSM_BUFFER_READ_NO_CHECK
-// // Data is stored in a buffer and we can both read and check the size
-// // of the buffer
-// #define TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
+// The way the modem buffers incoming data (its TinyGsmBufferMode) comes from
+// its TinyGsmModemTraits; the matching implementation of each function below
+// is picked by overloading on a TinyGsmBufferTag.
 
 template <class modemType, uint8_t muxCount>
 class TinyGsmTCP {
@@ -53,13 +106,46 @@ class TinyGsmTCP {
    * Basic functions
    */
   void maintain() {
+#if defined TINY_GSM_ASYNC_COMMANDS
+    // Don't block behind a queued command; poll() deals with its response
+    if (thisModem().commandsPending()) {
+      thisModem().poll();
+      return;
+    }
+#endif
+#if defined TINY_GSM_TX_BUFFER
+    flushDueTx();
+#endif
     return thisModem().maintainImpl();
   }
 
+#if defined TINY_GSM_RX_POOL
+  typedef TinyGsmRxPool<TINY_GSM_RX_POOL, TINY_GSM_RX_POOL_BLOCK> RxPool;
+
+  /**
+   * @brief The receive pool shared by the modem's clients, for its inUse(),
+   * highWater() and misses() counts
+   */
+  const RxPool& rxPool() const {
+    return rx_pool;
+  }
+
+  /**
+   * @brief Start the receive pool's high-water mark and miss count again
+   */
+  void resetRxPoolStats() {
+    rx_pool.resetStats();
+  }
+#endif
+
   /*
    * CRTP Helper
    */
  protected:
+#if defined TINY_GSM_SEND_WINDOW
+  TinyGsmTCP() : send_head(0), send_count(0) {}
+#endif
+
   inline const modemType& thisModem() const {
     return static_cast<const modemType&>(*this);
   }
@@ -75,9 +161,38 @@ class TinyGsmTCP {
   class GsmClient : public Client {
     // Make all classes created from the modem template friends
     friend class TinyGsmTCP<modemType, muxCount>;
-    typedef TinyGsmFifo<uint8_t, TINY_GSM_RX_BUFFER> RxFifo;
+    typedef TinyGsmModemTraits<modemType>          Traits;
+    typedef TinyGsmBufferTag<Traits::bufferMode>   BufferTag;
+#if defined TINY_GSM_RX_POOL
+    typedef TinyGsmPooledFifo<RxPool> RxFifo;
+#else
+    typedef TinyGsmFifo<uint8_t, 0> RxFifo;
+#endif
 
    public:
+    GsmClient()
+        : at(nullptr),
+          rx_direct(nullptr),
+          rx_direct_left(0),
+          poll_interval(TINY_GSM_POLL_MIN),
+          poll_min(TINY_GSM_POLL_MIN),
+          poll_max(TINY_GSM_POLL_MAX),
+          poll_count(0),
+          poll_hits(0),
+          conn_checked(0),
+          fast_close(false) {
+#if !defined TINY_GSM_RX_POOL
+      rx.setBuffer(Traits::rxBuffer ? rx_storage : nullptr, Traits::rxBuffer);
+#endif
+#if defined TINY_GSM_TX_BUFFER
+      tx_len      = 0;
+      tx_no_delay = false;
+#endif
+#if defined TINY_GSM_SEND_WINDOW
+      tx_in_flight = 0;
+#endif
+    }
+
     // bool init(modemType* modem, uint8_t);
     // int connect(const char* host, uint16_t port, int timeout_s);
 
@@ -112,11 +227,29 @@ class TinyGsmTCP {
     //   stop(15000L);
     // }
 
-    // Writes data out on the client using the modem send functionality
+    // Writes data out on the client using the modem send functionality, split
+    // into as many sends as the modem's largest send needs.  Returns the number
+    // of bytes the modem accepted.
     size_t write(const uint8_t* buf, size_t size) override {
       TINY_GSM_YIELD();
+#if defined TINY_GSM_TX_BUFFER
+      if (!tx_no_delay && size < sizeof(tx_buf)) {
+        for (size_t left = size; left;) {
+          if (!tx_len) tx_since = millis();
+          size_t n = TinyGsmMin(left, sizeof(tx_buf) - tx_len);
+          memcpy(tx_buf + tx_len, buf, n);
+          tx_len += n;
+          buf += n;
+          left -= n;
+          if (tx_len == sizeof(tx_buf) && !flushTx()) return 0;
+        }
+        return size;
+      }
+      // Larger writes go straight out, after anything held back
+      if (!flushTx()) return 0;
+#endif
       at->maintain();
-      return at->modemSend(buf, size, mux);
+      return sendChunked(buf, size);
     }
 
     size_t write(uint8_t c) override {
@@ -130,44 +263,215 @@ class TinyGsmTCP {
 
     int available() override {
       TINY_GSM_YIELD();
-#if defined TINY_GSM_NO_MODEM_BUFFER
-      // Returns the number of characters available in the TinyGSM fifo
+      flushTx();
+      return availableImpl(BufferTag());
+    }
+
+    int read(uint8_t* buf, size_t size) override {
+      TINY_GSM_YIELD();
+      flushTx();
+      return readImpl(buf, size, BufferTag());
+    }
+
+    int read() override {
+      uint8_t c;
+      if (read(&c, 1) == 1) { return c; }
+      return -1;
+    }
+
+    int peek() override {
+      if (!rx.size()) return -1;
+      return (uint8_t)rx.peek();
+    }
+
+    void flush() override {
+      flushTx();
+      at->stream.flush();
+    }
+
+    uint8_t connected() override {
+      if (available()) { return true; }
+      return connectedImpl(BufferTag());
+    }
+    operator bool() override {
+      return connected();
+    }
+
+    /*
+     * Extended API
+     */
+
+    String remoteIP() TINY_GSM_ATTR_NOT_IMPLEMENTED;
+
+#if defined TINY_GSM_TX_BUFFER
+    /**
+     * @brief Choose whether the client sends each write straight away rather
+     * than holding small ones back to send together
+     *
+     * @param noDelay True to send every write as it is made
+     */
+    void setNoDelay(bool noDelay) {
+      if (noDelay) flushTx();
+      tx_no_delay = noDelay;
+    }
+
+    bool getNoDelay() {
+      return tx_no_delay;
+    }
+#endif
+
+#if defined TINY_GSM_SEND_WINDOW
+    /**
+     * @brief The number of bytes sent that the modem has not acknowledged yet
+     *
+     * If the modem turns down a send after write() has returned, or doesn't
+     * acknowledge it within 5 s, the client's getWriteError() is set; in the
+     * second case the socket is also reported closed.
+     */
+    uint16_t bytesInFlight() {
+      return tx_in_flight;
+    }
+#endif
+
+    /**
+     * @brief Set how often the modem may be asked whether data has arrived
+     * that it did not announce, on modems that need it
+     *
+     * @param minMs The interval after any traffic on the socket
+     * @param maxMs The longest interval, reached by doubling after each poll
+     * that finds nothing
+     */
+    void setPollInterval(uint16_t minMs, uint16_t maxMs) {
+      poll_min      = minMs;
+      poll_max      = maxMs < minMs ? minMs : maxMs;
+      poll_interval = poll_min;
+    }
+
+    /**
+     * @brief The number of times the modem was asked about the socket without
+     * having announced any data
+     */
+    uint16_t pollCount() {
+      return poll_count;
+    }
+
+    /**
+     * @brief The number of those polls that found data waiting that no URC had
+     * announced
+     */
+    uint16_t pollHits() {
+      return poll_hits;
+    }
+
+    void resetPollStats() {
+      poll_count = 0;
+      poll_hits  = 0;
+    }
+
+    /**
+     * @brief Choose whether stop() closes the socket straight away, letting
+     * the modem drop any data that hasn't been read, rather than first reading
+     * it all out and throwing it away
+     *
+     * Data already on its way over the serial line is still cleared out.
+     *
+     * @param fastClose True to close without reading out the modem's buffer
+     */
+    void setFastClose(bool fastClose) {
+      fast_close = fastClose;
+    }
+
+    bool getFastClose() {
+      return fast_close;
+    }
+
+#if !defined TINY_GSM_RX_POOL
+    /**
+     * @brief Give the client its own receive FIFO in place of the built-in one
+     * of TINY_GSM_RX_BUFFER bytes
+     *
+     * Anything still in the old FIFO is dropped, so do this before connecting.
+     * Data that a read() can take straight into its own buffer never goes
+     * through the FIFO, so a client without one still works.
+     *
+     * @param buf The buffer, which must outlive the client; nullptr to go back
+     * to the built-in one
+     * @param len The size of the buffer; up to 65535 bytes, of which one is
+     * always kept free
+     */
+    void setRxBuffer(uint8_t* buf, size_t len) {
+      if (!buf) {
+        buf = Traits::rxBuffer ? rx_storage : nullptr;
+        len = Traits::rxBuffer;
+      }
+      rx.setBuffer(buf, len);
+    }
+#endif
+
+    /**
+     * @brief Get the received data that is waiting in the client's FIFO, to
+     * be looked at in place instead of copied out with read()
+     *
+     * If the FIFO is empty, it is first topped up from the modem the same way
+     * available() does.  Call consume() with however much was used.  The data
+     * may be split where the FIFO wraps, so once this run has been consumed
+     * there may be more.  A client without a FIFO always gets 0.
+     *
+     * @param len Set to the number of bytes at the returned pointer; 0 if
+     * there is nothing to read
+     * @return *const uint8_t** The next unread byte
+     */
+    const uint8_t* peekBuffer(size_t& len) {
+      TINY_GSM_YIELD();
+      if (!rx.size()) { fillFifo(BufferTag()); }
+      int            n;
+      const uint8_t* p = rx.readableSpan(n);
+      len              = n;
+      return p;
+    }
+
+    /**
+     * @brief Drop bytes from the front of the FIFO, after peekBuffer()
+     *
+     * @param len The number of bytes to drop; no more than are in the FIFO
+     * are dropped
+     */
+    void consume(size_t len) {
+      rx.consume(TinyGsmMin(len, rx.size()));
+    }
+
+   protected:
+    // Returns the number of characters available in the TinyGSM fifo
+    int availableImpl(TinyGsmBufferTag<GSM_NO_MODEM_BUFFER>) {
       if (!rx.size() && sock_connected) { at->maintain(); }
       return rx.size();
+    }
 
-#elif defined TINY_GSM_BUFFER_READ_NO_CHECK
-      // Returns the combined number of characters available in the TinyGSM
-      // fifo and the modem chips internal fifo.
+    // Returns the combined number of characters available in the TinyGSM
+    // fifo and the modem chips internal fifo.
+    int availableImpl(TinyGsmBufferTag<GSM_BUFFER_READ_NO_CHECK>) {
       if (!rx.size()) { at->maintain(); }
       return static_cast<uint16_t>(rx.size()) + sock_available;
+    }
 
-#elif defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
-      // Returns the combined number of characters available in the TinyGSM
-      // fifo and the modem chips internal fifo, doing an extra check-in
-      // with the modem to see if anything has arrived without a UURC.
+    // Returns the combined number of characters available in the TinyGSM
+    // fifo and the modem chips internal fifo, doing an extra check-in
+    // with the modem to see if anything has arrived without a UURC.
+    int availableImpl(TinyGsmBufferTag<GSM_BUFFER_READ_AND_CHECK_SIZE>) {
       if (!rx.size()) {
-        if (millis() - prev_check > 500) {
-          // setting got_data to true will tell maintain to run
-          // modemGetAvailable(mux)
-          got_data   = true;
-          prev_check = millis();
-        }
+        bool polled = startPoll();
         at->maintain();
+        endPoll(polled);
       }
       return static_cast<uint16_t>(rx.size()) + sock_available;
-
-#else
-#error Modem client has been incorrectly created
-#endif
     }
 
-    int read(uint8_t* buf, size_t size) override {
-      TINY_GSM_YIELD();
-      size_t cnt = 0;
-
-#if defined TINY_GSM_NO_MODEM_BUFFER
-      // Reads characters out of the TinyGSM fifo, waiting for any URC's
-      // from the modem for new data if there's nothing in the fifo.
+    // Reads characters out of the TinyGSM fifo, waiting for any URC's
+    // from the modem for new data if there's nothing in the fifo.  Data that
+    // arrives while the fifo is empty goes straight into the user's buffer.
+    int readImpl(uint8_t* buf, size_t size,
+                 TinyGsmBufferTag<GSM_NO_MODEM_BUFFER>) {
+      size_t   cnt          = 0;
       uint32_t _startMillis = millis();
       while (cnt < size && millis() - _startMillis < _timeout) {
         size_t chunk = TinyGsmMin(size - cnt, rx.size());
@@ -176,14 +480,21 @@ class TinyGsmTCP {
           buf += chunk;
           cnt += chunk;
           continue;
-        } /* TODO: Read directly into user buffer? */
-        if (!rx.size() && sock_connected) { at->maintain(); }
+        }
+        if (sock_connected) {
+          size_t direct = readDirect(buf, size - cnt);
+          buf += direct;
+          cnt += direct;
+        }
       }
       return cnt;
+    }
 
-#elif defined TINY_GSM_BUFFER_READ_NO_CHECK
-      // Reads characters out of the TinyGSM fifo, and from the modem chip's
-      // internal fifo if avaiable.
+    // Reads characters out of the TinyGSM fifo, and from the modem chip's
+    // internal fifo if avaiable.
+    int readImpl(uint8_t* buf, size_t size,
+                 TinyGsmBufferTag<GSM_BUFFER_READ_NO_CHECK>) {
+      size_t cnt = 0;
       at->maintain();
       while (cnt < size) {
         size_t chunk = TinyGsmMin(size - cnt, rx.size());
@@ -191,23 +502,29 @@ class TinyGsmTCP {
           rx.get(buf, chunk);
           buf += chunk;
           cnt += chunk;
-          continue;
-        } /* TODO: Read directly into user buffer? */
+          // Don't go back to the modem for whatever is left; the next read
+          // finds the fifo empty and can ask for a full buffer's worth
+          break;
+        }
         at->maintain();
         if (sock_available > 0) {
-          int n = at->modemRead(TinyGsmMin((uint16_t)rx.free(), sock_available),
-                                mux);
-          if (n == 0) break;
+          size_t direct = readDirect(buf, size - cnt);
+          if (direct == 0 && !rx.size()) break;
+          buf += direct;
+          cnt += direct;
         } else {
           break;
         }
       }
       return cnt;
+    }
 
-#elif defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
-      // Reads characters out of the TinyGSM fifo, and from the modem chips
-      // internal fifo if avaiable, also double checking with the modem if
-      // data has arrived without issuing a UURC.
+    // Reads characters out of the TinyGSM fifo, and from the modem chips
+    // internal fifo if avaiable, also double checking with the modem if
+    // data has arrived without issuing a UURC.
+    int readImpl(uint8_t* buf, size_t size,
+                 TinyGsmBufferTag<GSM_BUFFER_READ_AND_CHECK_SIZE>) {
+      size_t cnt = 0;
       at->maintain();
       while (cnt < size) {
         size_t chunk = TinyGsmMin(size - cnt, rx.size());
@@ -215,101 +532,232 @@ class TinyGsmTCP {
           rx.get(buf, chunk);
           buf += chunk;
           cnt += chunk;
-          continue;
+          // Don't go back to the modem for whatever is left; the next read
+          // finds the fifo empty and can ask for a full buffer's worth
+          break;
         }
         // Workaround: Some modules "forget" to notify about data arrival
-        if (millis() - prev_check > 500) {
-          // setting got_data to true will tell maintain to run
-          // modemGetAvailable()
-          got_data   = true;
-          prev_check = millis();
-        }
-        // TODO(vshymanskyy): Read directly into user buffer?
+        bool polled = startPoll();
         at->maintain();
+        endPoll(polled);
         if (sock_available > 0) {
-          int n = at->modemRead(TinyGsmMin((uint16_t)rx.free(), sock_available),
-                                mux);
-          if (n == 0) break;
+          size_t direct = readDirect(buf, size - cnt);
+          if (direct == 0 && !rx.size()) break;
+          buf += direct;
+          cnt += direct;
         } else {
           break;
         }
       }
       return cnt;
+    }
 
-#else
-#error Modem client has been incorrectly created
+    // Lets the modem move socket data straight into buf, which holds up to
+    // size bytes; only what doesn't fit there goes into the fifo.  The modem
+    // is asked for enough to fill both, up to the most it will send at once.
+    // Must only be called while the fifo is empty, or the data would come out
+    // of order.
+    size_t readDirect(uint8_t* buf, size_t size) {
+      return readDirect(buf, size, BufferTag());
+    }
+
+    template <TinyGsmBufferMode mode>
+    size_t readDirect(uint8_t* buf, size_t size, TinyGsmBufferTag<mode>) {
+      bindRxPool();
+      rx_direct      = buf;
+      rx_direct_left = size;
+      size_t want    = TinyGsmMin(size + rx.free(),
+                                  static_cast<size_t>(sock_available));
+      at->modemRead(TinyGsmMin(want, static_cast<size_t>(Traits::maxRecv)),
+                    mux);
+      return endDirect(size);
+    }
+
+    // Without a modem buffer the data comes in URCs, so just listen for them
+    size_t readDirect(uint8_t* buf, size_t size,
+                      TinyGsmBufferTag<GSM_NO_MODEM_BUFFER>) {
+      rx_direct      = buf;
+      rx_direct_left = size;
+      at->maintain();
+      return endDirect(size);
+    }
+
+    // Stops reading into the user's buffer and returns how much went there
+    size_t endDirect(size_t size) {
+      size_t direct  = size - rx_direct_left;
+      rx_direct      = nullptr;
+      rx_direct_left = 0;
+      return direct;
+    }
+
+    // The number of bytes that can be taken in before anything is lost
+    size_t rxRoom() {
+      bindRxPool();
+      return rx_direct_left + rx.free();
+    }
+
+    // Points the fifo at the receive pool of the modem the client belongs to.
+    // That is only known once the driver's init() has set at, so this is done
+    // wherever data is about to go into the fifo.
+    void bindRxPool() {
+#if defined TINY_GSM_RX_POOL
+      if (at && rx.pool() != &at->rx_pool) {
+        rx.setPool(&at->rx_pool, TINY_GSM_RX_POOL_PER_SOCKET);
+      }
 #endif
     }
 
-    int read() override {
-      uint8_t c;
-      if (read(&c, 1) == 1) { return c; }
-      return -1;
+    // Hands data to the modem in sends of at most Traits::maxSend bytes, one
+    // straight after another, stopping at the first one the modem doesn't take
+    // all of.  Returns the number of bytes the modem accepted.
+    size_t sendChunked(const uint8_t* buf, size_t size) {
+      size_t sent = 0;
+      while (sent < size) {
+        size_t  n = TinyGsmMin(size - sent,
+                               static_cast<size_t>(Traits::maxSend));
+        int16_t r = at->modemSend(buf + sent, n, mux);
+        if (r <= 0) break;
+        sent += TinyGsmMin(static_cast<size_t>(r), n);
+        if (static_cast<size_t>(r) < n) break;
+      }
+      // A reply may be on its way, so look for it sooner
+      if (sent) poll_interval = poll_min;
+      return sent;
     }
 
-    int peek() override {
-      return (uint8_t)rx.peek();
+    // Flags the socket for the next maintain() to ask the modem about, if
+    // nothing is known to be waiting and the poll interval has passed.
+    // Returns whether it did.
+    bool startPoll() {
+      if (sock_available || got_data) return false;
+      if (millis() - prev_check <= poll_interval) return false;
+      // setting got_data to true will tell maintain to run
+      // modemGetAvailable(mux)
+      got_data   = true;
+      prev_check = millis();
+      poll_count++;
+      return true;
     }
 
-    void flush() override {
-      at->stream.flush();
+    // Counts a poll that found data, and sets when the next one is due: soon
+    // if there is data, otherwise twice as long after a poll that found none
+    // (starting from 1 ms if the minimum is 0).  The poll's own query clears
+    // got_data, so if it is set again a URC came in during the same
+    // maintain(); whatever is waiting then isn't the poll's find.
+    void endPoll(bool polled) {
+      if (polled) {
+        if (sock_available && !got_data) {
+          poll_hits++;
+          poll_interval = poll_min;
+        } else {
+          uint32_t next = poll_interval ? 2UL * poll_interval : 1;
+          poll_interval = next > poll_max ? poll_max : next;
+        }
+      } else if (sock_available) {
+        poll_interval = poll_min;
+      }
     }
 
-    uint8_t connected() override {
-      if (available()) { return true; }
-#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
-      // If the modem is one where we can read and check the size of the buffer,
-      // then the 'available()' function will call a check of the current size
-      // of the buffer and state of the connection. [available calls maintain,
-      // maintain calls modemGetAvailable, modemGetAvailable calls
-      // modemGetConnected]  This cascade means that the sock_connected value
-      // should be correct and all we need
-      return sock_connected;
-#elif defined TINY_GSM_NO_MODEM_BUFFER || defined TINY_GSM_BUFFER_READ_NO_CHECK
-      // If the modem doesn't have an internal buffer, or if we can't check how
-      // many characters are in the buffer then the cascade won't happen.
-      // We need to call modemGetConnected to check the sock state.
-      return at->modemGetConnected(mux);
+    // Sends the writes being held back, if any.  They are let go of either
+    // way, so returns false if the modem didn't take all of them.
+    bool flushTx() {
+#if defined TINY_GSM_TX_BUFFER
+      if (!tx_len) return true;
+      uint16_t len = tx_len;
+      tx_len       = 0;
+      if (!sock_connected) return false;
+      return sendChunked(tx_buf, len) == len;
 #else
-#error Modem client has been incorrectly created
+      return true;
 #endif
     }
-    operator bool() override {
-      return connected();
+
+    // Checks in with the modem as available() does and, if the modem is holding
+    // data for us, reads as much of it into the fifo as fits.
+    template <TinyGsmBufferMode mode>
+    void fillFifo(TinyGsmBufferTag<mode> tag) {
+      availableImpl(tag);
+      bindRxPool();
+      if (rx.size() || !sock_available || !rx.free()) return;
+      size_t want = TinyGsmMin(static_cast<size_t>(rx.free()),
+                               static_cast<size_t>(sock_available));
+      at->modemRead(TinyGsmMin(want, static_cast<size_t>(Traits::maxRecv)),
+                    mux);
     }
 
-    /*
-     * Extended API
-     */
+    // Without a modem buffer the data arrives in URCs, which available()
+    // already listens for
+    void fillFifo(TinyGsmBufferTag<GSM_NO_MODEM_BUFFER> tag) {
+      availableImpl(tag);
+    }
 
-    String remoteIP() TINY_GSM_ATTR_NOT_IMPLEMENTED;
+    // If the modem is one where we can read and check the size of the buffer,
+    // then the 'available()' function will call a check of the current size
+    // of the buffer and state of the connection. [available calls maintain,
+    // maintain calls modemGetAvailable, modemGetAvailable calls
+    // modemGetConnected]  This cascade means that the sock_connected value
+    // should be correct and all we need
+    uint8_t connectedImpl(TinyGsmBufferTag<GSM_BUFFER_READ_AND_CHECK_SIZE>) {
+      return sock_connected;
+    }
 
-   protected:
-    // Read and dump anything remaining in the modem's internal buffer.
-    // Using this in the client stop() function.
+    // If the modem doesn't have an internal buffer, or if we can't check how
+    // many characters are in the buffer then the cascade won't happen.
+    // We need to call modemGetConnected to check the sock state.
+    // The answer is kept for TINY_GSM_CONNECTED_TTL ms, though, since asking
+    // on every call from a library's loop would keep the modem busy.
+    template <TinyGsmBufferMode mode>
+    uint8_t connectedImpl(TinyGsmBufferTag<mode>) {
+      if (!sock_connected || !connectedCheckDue()) return sock_connected;
+      sock_connected = at->modemGetConnected(mux);
+      return sock_connected;
+    }
+
+    // Whether TINY_GSM_CONNECTED_TTL ms have passed since the modem was last
+    // asked if the socket is open; if so, the time is taken as asked from now
+    bool connectedCheckDue() {
+      if (millis() - conn_checked < TINY_GSM_CONNECTED_TTL) return false;
+      conn_checked = millis();
+      return true;
+    }
+
+    // Send anything still held back, then read and dump anything remaining in
+    // the modem's internal buffer.  Using this in the client stop() function.
     // The socket will appear open in response to connected() even after it
     // closes until all data is read from the buffer.
     // Doing it this way allows the external mcu to find and get all of the
     // data that it wants from the socket even if it was closed externally.
+    // With fast close the buffer is left for the modem to drop on closing.
     inline void dumpModemBuffer(uint32_t maxWaitMs) {
-#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE || \
-    defined TINY_GSM_BUFFER_READ_NO_CHECK
+      flushTx();
+#if defined TINY_GSM_SEND_WINDOW
+      // The stream is about to be cleared, acknowledgements and all
+      at->waitInFlight(mux, 0);
+#endif
+      dumpModemBuffer(fast_close ? 0 : maxWaitMs, BufferTag());
+    }
+
+    template <TinyGsmBufferMode mode>
+    inline void dumpModemBuffer(uint32_t maxWaitMs, TinyGsmBufferTag<mode>) {
       TINY_GSM_YIELD();
       uint32_t startMillis = millis();
       while (sock_available > 0 && (millis() - startMillis < maxWaitMs)) {
+        // Whatever doesn't fit in the fifo is dropped on the way in anyway
         rx.clear();
-        at->modemRead(TinyGsmMin((uint16_t)rx.free(), sock_available), mux);
+        at->modemRead(
+            TinyGsmMin(sock_available, static_cast<uint16_t>(Traits::maxRecv)),
+            mux);
       }
+      // Whatever is left goes when the socket is closed
+      sock_available = 0;
       rx.clear();
       at->streamClear();
+    }
 
-#elif defined TINY_GSM_NO_MODEM_BUFFER
+    inline void dumpModemBuffer(uint32_t,
+                                TinyGsmBufferTag<GSM_NO_MODEM_BUFFER>) {
       rx.clear();
       at->streamClear();
-
-#else
-#error Modem client has been incorrectly created
-#endif
     }
 
     modemType* at;
@@ -319,6 +767,29 @@ class TinyGsmTCP {
     bool       sock_connected;
     bool       got_data;
     RxFifo     rx;
+    uint8_t*   rx_direct;       /// The user buffer a read() is filling, if any
+    size_t     rx_direct_left;  /// The room left in rx_direct
+    uint16_t   poll_interval;   /// The time to leave before the next poll
+    uint16_t   poll_min;        /// The poll interval after traffic
+    uint16_t   poll_max;        /// The longest poll interval
+    uint16_t   poll_count;      /// The polls made
+    uint16_t   poll_hits;       /// The polls that found data waiting
+    uint32_t   conn_checked;    /// When the modem was last asked if open
+    bool       fast_close;      /// Whether stop() leaves the buffer unread
+#if !defined TINY_GSM_RX_POOL
+    /// The built-in fifo buffer; one unused byte if TINY_GSM_RX_BUFFER is 0
+    uint8_t rx_storage[Traits::rxBuffer ? Traits::rxBuffer : 1];
+#endif
+#if defined TINY_GSM_TX_BUFFER
+    /// Writes held back to send together
+    uint8_t  tx_buf[TINY_GSM_TX_BUFFER];
+    uint16_t tx_len;       /// The number of bytes in tx_buf
+    uint32_t tx_since;     /// When the first held back byte was written
+    bool     tx_no_delay;  /// Whether writes go straight out
+#endif
+#if defined TINY_GSM_SEND_WINDOW
+    uint16_t tx_in_flight;  /// Bytes sent but not acknowledged yet
+#endif
   };
 
   /* =========================================== */
@@ -332,9 +803,23 @@ class TinyGsmTCP {
    */
  protected:
   void maintainImpl() {
-#if defined TINY_GSM_BUFFER_READ_AND_CHECK_SIZE
-    // Keep listening for modem URC's and proactively iterate through
-    // sockets asking if any data is avaiable
+    maintainImpl(TinyGsmBufferTag<TinyGsmModemTraits<modemType>::bufferMode>());
+  }
+
+  void maintainImpl(TinyGsmBufferTag<GSM_BUFFER_READ_AND_CHECK_SIZE>) {
+    // Keep listening for modem URC's and proactively check on the sockets
+    // that may have data waiting
+    thisModem().modemRefreshSockets();
+    while (thisModem().stream.available()) {
+      thisModem().waitResponse(15, nullptr, nullptr);
+    }
+  }
+
+  // Brings sock_available, and with it sock_connected, up to date for every
+  // socket with got_data set, asking the modem about each one in turn.
+  // Drivers whose modem reports on all of its sockets in one command override
+  // this to ask just once per maintain().
+  void modemRefreshSockets() {
     for (int mux = 0; mux < muxCount; mux++) {
       GsmClient* sock = thisModem().sockets[mux];
       if (sock && sock->got_data) {
@@ -342,35 +827,247 @@ class TinyGsmTCP {
         sock->sock_available = thisModem().modemGetAvailable(mux);
       }
     }
-    while (thisModem().stream.available()) {
-      thisModem().waitResponse(15, nullptr, nullptr);
-    }
+  }
 
-#elif defined TINY_GSM_NO_MODEM_BUFFER || defined TINY_GSM_BUFFER_READ_NO_CHECK
+  template <TinyGsmBufferMode mode>
+  void maintainImpl(TinyGsmBufferTag<mode>) {
     // Just listen for any URC's
     thisModem().waitResponse(100, nullptr, nullptr);
+  }
 
-#else
-#error Modem client has been incorrectly created
+  // Moves len bytes of socket data from the stream to the client on mux.  They
+  // go straight into the buffer a read() on that client is filling, if there
+  // is one, and otherwise into the client's FIFO, in blocks of whatever the
+  // stream has ready.  It gives up once the stream has been idle for the
+  // socket time-out, so a slow serial line only has to keep the bytes coming,
+  // not deliver the whole payload within it.  Bytes that don't fit anywhere
+  // are read and dropped so the stream stays in step with the modem.  Returns
+  // the number of bytes taken off the stream.
+  size_t moveStreamToClient(uint8_t mux, int len) {
+    GsmClient* sock = thisModem().sockets[mux];
+    if (!sock || len <= 0) return 0;
+    sock->bindRxPool();
+    Stream&  stream      = thisModem().stream;
+    size_t   left        = len;
+    uint32_t startMillis = millis();
+    while (left) {
+      int avail = stream.available();
+      if (avail <= 0) {
+        if (millis() - startMillis >= sock->_timeout) break;
+        TINY_GSM_YIELD();
+        continue;
+      }
+      startMillis = millis();  // the time-out runs from the latest bytes
+      uint8_t* dst;
+      size_t   room;
+      if (sock->rx_direct_left) {
+        dst  = sock->rx_direct;
+        room = sock->rx_direct_left;
+      } else {
+        int span;
+        dst  = sock->rx.writableSpan(span);
+        room = span;
+      }
+      if (!room) {
+        stream.read();
+        left--;
+        continue;
+      }
+      size_t n = TinyGsmMin(TinyGsmMin(left, room), static_cast<size_t>(avail));
+      n        = stream.readBytes(dst, n);
+      if (sock->rx_direct_left) {
+        sock->rx_direct += n;
+        sock->rx_direct_left -= n;
+      } else {
+        sock->rx.commit(n);
+      }
+      left -= n;
+    }
+    return len - left;
+  }
+
+#if defined TINY_GSM_SEND_WINDOW
+  struct PendingSend {
+    uint8_t  mux;
+    uint16_t len;
+  };
+
+  // Notes a send whose payload has gone out but whose acknowledgement hasn't
+  // arrived yet.  Call waitSendWindow() before starting it.
+  void sendPending(uint8_t mux, uint16_t len) {
+    PendingSend& p = pendingSend(send_count);
+    p.mux          = mux;
+    p.len          = len;
+    send_count++;
+    GsmClient* sock = thisModem().sockets[mux];
+    if (sock) sock->tx_in_flight += len;
+  }
+
+  // Settles the oldest send waiting for an acknowledgement, for modems whose
+  // acknowledgement doesn't say which socket it is for.  Those take each send
+  // in turn, so they acknowledge them in the order they were made.
+  void sendAcked(bool ok) {
+    if (send_count) sendSettle(0, ok);
+  }
+
+  // Settles the oldest send on mux waiting for an acknowledgement, for modems
+  // that name the socket and the number of bytes they took
+  void sendAcked(uint8_t mux, uint16_t len, bool ok) {
+    for (uint8_t i = 0; i < send_count; i++) {
+      PendingSend& p = pendingSend(i);
+      if (p.mux != mux) continue;
+      sendSettle(i, ok && len >= p.len);
+      return;
+    }
+  }
+
+  // The i'th oldest send waiting for an acknowledgement
+  PendingSend& pendingSend(uint8_t i) {
+    return send_queue[(send_head + i) % TINY_GSM_SEND_QUEUE];
+  }
+
+  // Takes the i'th oldest send off the queue, moving the later ones up, and
+  // counts its bytes as no longer in flight.  write() has already returned
+  // for a send that fails, so the failure is flagged on the client for
+  // getWriteError().
+  void sendSettle(uint8_t i, bool ok) {
+    PendingSend p = pendingSend(i);
+    for (; i + 1 < send_count; i++) { pendingSend(i) = pendingSend(i + 1); }
+    send_count--;
+    GsmClient* sock = thisModem().sockets[p.mux];
+    if (!sock) return;
+    sock->tx_in_flight -= TinyGsmMin(sock->tx_in_flight, p.len);
+    if (!ok) {
+      DBG("### Send failed on", p.mux);
+      sock->setWriteError();
+    }
+  }
+
+  // Listens for acknowledgements until a send of len more bytes on mux fits
+  // in the window.  A send larger than the window waits for all the earlier
+  // ones.
+  bool waitSendWindow(uint8_t mux, uint16_t len) {
+    return waitInFlight(mux, len < TINY_GSM_SEND_WINDOW
+                                 ? TINY_GSM_SEND_WINDOW - len
+                                 : 0);
+  }
+
+  // Listens for acknowledgements until mux has no more than most bytes in
+  // flight and there is room to note another send.  If they stop coming, the
+  // socket that is waited on is given up on: mux, or if it has nothing in
+  // flight, the one with the oldest send.
+  bool waitInFlight(uint8_t mux, uint16_t most) {
+    GsmClient* sock  = thisModem().sockets[mux];
+    uint32_t   start = millis();
+    while (send_count == TINY_GSM_SEND_QUEUE ||
+           (sock && sock->tx_in_flight > most)) {
+      if (millis() - start > 5000L) {
+        sendGiveUp(sock && sock->tx_in_flight ? mux : pendingSend(0).mux);
+        return false;
+      }
+      thisModem().waitResponse(10, nullptr, nullptr);
+    }
+    return true;
+  }
+
+  // Fails every send still waiting on mux, and marks the socket closed since
+  // the modem has stopped taking its data
+  void sendGiveUp(uint8_t mux) {
+    DBG("### No acknowledgement for sends on", mux);
+    for (uint8_t i = send_count; i-- > 0;) {
+      if (pendingSend(i).mux == mux) sendSettle(i, false);
+    }
+    GsmClient* sock = thisModem().sockets[mux];
+    if (sock) sock->sock_connected = false;
+  }
 #endif
+
+#if defined TINY_GSM_TX_BUFFER
+  // Sends the writes any client has been holding back for TINY_GSM_TX_DELAY
+  void flushDueTx() {
+    for (uint8_t mux = 0; mux < muxCount; mux++) {
+      GsmClient* sock = thisModem().sockets[mux];
+      if (sock && sock->tx_len &&
+          millis() - sock->tx_since >= TINY_GSM_TX_DELAY) {
+        sock->flushTx();
+      }
+    }
   }
+#endif
 
-  // Yields up to a time-out period and then reads a character from the stream
-  // into the mux FIFO
-  // TODO(SRGDamia1):  Do we really need to wait _two_ timeout periods for no
-  // character return?  Will wait once in the first "while
-  // !stream.available()" and then will wait again in the stream.read()
-  // function.
-  inline void moveCharFromStreamToFifo(uint8_t mux) {
-    if (!thisModem().sockets[mux]) return;
-    uint32_t startMillis = millis();
-    while (!thisModem().stream.available() &&
-           (millis() - startMillis < thisModem().sockets[mux]->_timeout)) {
-      TINY_GSM_YIELD();
+  // Keeps count of the data the modem still holds for the client on mux after
+  // a read that asked for requested bytes and got received, so that the modem
+  // only has to be asked when the count can't be known.  A short read means
+  // the modem has nothing left.  Otherwise the count goes down by what was
+  // read, and it can't be wrong by more than what arrived since; once it comes
+  // to nothing, the next maintain() asks the modem whether more has come.
+  void accountRead(uint8_t mux, size_t requested, int16_t received) {
+    GsmClient* sock = thisModem().sockets[mux];
+    if (!sock) return;
+    if (received >= 0 && static_cast<size_t>(received) < requested) {
+      sock->sock_available = 0;
+      return;
     }
-    char c = thisModem().stream.read();
-    thisModem().sockets[mux]->rx.put(c);
+    if (received > 0) {
+      sock->sock_available -= TinyGsmMin(
+          sock->sock_available, static_cast<uint16_t>(received));
+    }
+    if (!sock->sock_available) sock->got_data = true;
   }
+
+  // Hands one already decoded byte of socket data to the client on mux, the
+  // same way as moveStreamToClient
+  inline void putCharToClient(uint8_t mux, uint8_t c) {
+    GsmClient* sock = thisModem().sockets[mux];
+    if (!sock) return;
+    if (sock->rx_direct_left) {
+      *sock->rx_direct++ = c;
+      sock->rx_direct_left--;
+    } else {
+      sock->bindRxPool();
+      sock->rx.put(c);
+    }
+  }
+
+#if defined TINY_GSM_RX_POOL
+  RxPool rx_pool;  /// The blocks the clients' FIFOs borrow
+#endif
+#if defined TINY_GSM_SEND_WINDOW
+  PendingSend send_queue[TINY_GSM_SEND_QUEUE];  /// Sends not acknowledged yet
+  uint8_t     send_head;   /// The oldest of them
+  uint8_t     send_count;  /// The number of them
+#endif
 };
 
+#if !defined TINY_GSM_RX_POOL
+/**
+ * @brief A client with a receive FIFO of its own size, in place of the
+ * built-in one of TINY_GSM_RX_BUFFER bytes
+ *
+ * @code
+ * TinyGsmBufferedClient<TinyGsmClient, 4096> download(modem, 0);
+ * TinyGsmClient                              telemetry(modem, 1);
+ * @endcode
+ *
+ * @tparam ClientType The modem's client class, such as TinyGsmClient
+ * @tparam N The size of the FIFO, up to 65535 bytes
+ */
+template <class ClientType, uint16_t N>
+class TinyGsmBufferedClient : public ClientType {
+ public:
+  TinyGsmBufferedClient() {
+    this->setRxBuffer(rxBuffer, N);
+  }
+
+  template <class modemType>
+  explicit TinyGsmBufferedClient(modemType& modem, uint8_t mux = 0)
+      : ClientType(modem, mux) {
+    this->setRxBuffer(rxBuffer, N);
+  }
+
+ private:
+  uint8_t rxBuffer[N];
+};
+#endif
+
 #endif  // SRC_TINYGSMTCP_H_
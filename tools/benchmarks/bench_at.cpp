@@ -0,0 +1,73 @@
+/**
+ * @file       bench_at.cpp
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * Outgoing commands: counts the Stream write() calls sendAT() makes per
+ * command, each of which would be a UART driver call on a board, and checks
+ * that the command and response buffers still work when sized past 255.
+ *
+ * Build and run from this directory:
+ *   g++ -std=c++11 -O2 -Ihost -I../../src bench_at.cpp host/host.cpp \
+ *       -o bench_at && ./bench_at
+ *
+ * Add e.g. -DTINY_GSM_AT_BUFFER=16 to see a command written in pieces.
+ */
+
+#define TINY_GSM_MODEM_SIM800
+
+#include "HostStream.h"
+
+#include <TinyGsmClient.h>
+
+// sendAT() is protected
+class Modem : public TinyGsm {
+ public:
+  explicit Modem(Stream& stream) : TinyGsm(stream) {}
+  using TinyGsm::sendAT;
+};
+
+static HostStream fs;
+
+static bool report(const char* name, const std::string& want) {
+  bool ok = fs.out == want;
+  printf("%-10s %2zu write() calls for %3zu bytes%s\n", name, fs.writes,
+         fs.out.size(), ok ? "" : "  WRONG OUTPUT");
+  fs.out.clear();
+  fs.writes = 0;
+  return ok;
+}
+
+int main() {
+  Modem modem(fs);
+  bool  ok = true;
+
+  modem.sendAT(GF("+CSQ"));
+  ok &= report("+CSQ", "AT+CSQ\r\n");
+
+  modem.sendAT(GF("+CIPSEND="), 1, ',', static_cast<uint16_t>(100));
+  ok &= report("+CIPSEND", "AT+CIPSEND=1,100\r\n");
+
+  String host = "example.com";
+  modem.sendAT(GF("+CIPSTART="), 0, ',', GF("\"TCP"), GF("\",\""), host,
+               GF("\","), 80);
+  ok &= report("+CIPSTART", "AT+CIPSTART=0,\"TCP\",\"example.com\",80\r\n");
+
+  std::string apn(150, 'x');
+  modem.sendAT(GF("+CGDCONT=1,\"IP\",\""), apn.c_str(), '"');
+  ok &= report("long APN", "AT+CGDCONT=1,\"IP\",\"" + apn + "\"\r\n");
+
+  // Buffers past 255 bytes must neither wrap nor truncate
+  std::string               big(299, 'y');
+  TinyGsmCommandBuffer<300> cmd;
+  TinyGsmLineBuffer<300>    line;
+  for (size_t i = 0; i < big.size(); i++) {
+    cmd.write(big[i]);
+    line += big[i];
+  }
+  cmd.sendTo(fs);
+  bool wide = !cmd.overflowed() && fs.out == big && line.length() == 299 &&
+      line.c_str() == big;
+  printf("300-byte buffers: %s\n", wide ? "ok" : "WRONG");
+  return ok && wide ? 0 : 1;
+}
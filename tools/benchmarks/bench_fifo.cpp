@@ -0,0 +1,91 @@
+/**
+ * @file       bench_fifo.cpp
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * TinyGsmFifo: nanoseconds per put+get pair, one byte at a time and 48 bytes
+ * at a time, for FIFOs of a few sizes over built-in storage and over a buffer
+ * handed to setBuffer(), as the clients' receive FIFOs are.  Each operation
+ * sits behind a call that isn't inlined, as when a driver fills the FIFO and
+ * the application empties it.  The best of five runs is shown.
+ *
+ * Build and run from this directory:
+ *   g++ -std=c++11 -O2 -Ihost -I../../src bench_fifo.cpp host/host.cpp \
+ *       -o bench_fifo && ./bench_fifo
+ *
+ * GCC may inline the 48-byte copies as "rep movs", which on some CPUs is
+ * slower than a memcpy call for short runs; add -mstringop-strategy=libcall
+ * to compare the FIFO code rather than the copy.
+ */
+
+#include "Arduino.h"
+
+#include <TinyGsmFifo.h>
+
+template <class Fifo>
+struct Ops {
+  static Fifo f;
+  __attribute__((noinline)) static bool put1(uint8_t c) {
+    return f.put(c);
+  }
+  __attribute__((noinline)) static bool get1(uint8_t* c) {
+    return f.get(c);
+  }
+  __attribute__((noinline)) static int putn(const uint8_t* p, int n) {
+    return f.put(p, n);
+  }
+  __attribute__((noinline)) static int getn(uint8_t* p, int n) {
+    return f.get(p, n);
+  }
+};
+template <class Fifo>
+Fifo Ops<Fifo>::f;
+
+static double nsSince(std::chrono::steady_clock::time_point t0, long n) {
+  return std::chrono::duration<double, std::nano>(
+             std::chrono::steady_clock::now() - t0)
+             .count() /
+      n;
+}
+
+template <class Fifo>
+static void bench(const char* name) {
+  typedef Ops<Fifo> O;
+  volatile uint8_t  sink  = 0;
+  double            byte1 = 1e9, bulk = 1e9;
+  uint8_t           in[48], out[48];
+  for (int i = 0; i < 48; i++) in[i] = i;
+
+  for (int run = 0; run < 5; run++) {
+    const long n1 = 10000000;
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (long i = 0; i < n1; i++) {
+      uint8_t c;
+      O::put1(static_cast<uint8_t>(i));
+      O::get1(&c);
+      sink += c;
+    }
+    byte1 = std::min(byte1, nsSince(t0, n1));
+
+    const long n48 = 2000000;
+    t0             = std::chrono::steady_clock::now();
+    for (long i = 0; i < n48; i++) {
+      O::putn(in, 48);
+      O::getn(out, 48);
+      sink += out[7];
+    }
+    bulk = std::min(bulk, nsSince(t0, n48));
+  }
+  printf("%-14s 1 byte %5.2f ns   48 bytes %6.2f ns\n", name, byte1, bulk);
+}
+
+static uint8_t external[100];
+
+int main() {
+  bench<TinyGsmFifo<uint8_t, 64> >("N = 64");
+  bench<TinyGsmFifo<uint8_t, 100> >("N = 100");
+  bench<TinyGsmFifo<uint8_t, 512> >("N = 512");
+  Ops<TinyGsmFifo<uint8_t, 0> >::f.setBuffer(external, sizeof(external));
+  bench<TinyGsmFifo<uint8_t, 0> >("setBuffer(100)");
+  return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file       bench_matcher.cpp
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * Response parsing: checks TinyGsmMatcher against a plain endsWith() over
+ * random data with overlapping patterns, then times waitResponse() on
+ * repeated SIM800 +CSQ / +CIPRXGET traffic.
+ *
+ * Build and run from this directory:
+ *   g++ -std=c++11 -O2 -Ihost -I../../src bench_matcher.cpp host/host.cpp \
+ *       -o bench_matcher && ./bench_matcher
+ */
+
+#define TINY_GSM_MODEM_SIM800
+
+#include "HostStream.h"
+
+#include <TinyGsmClient.h>
+
+// Every slot must report a match exactly when the data fed so far ends with
+// its pattern, including after another slot has matched
+static bool checkMatcher() {
+  static const char* const pats[] = {"OK\r\n", "ERROR\r\n", "aab", "abab",
+                                     "b",      "abaab"};
+  const uint8_t            n      = sizeof(pats) / sizeof(pats[0]);
+  TinyGsmMatcher<8>        m;
+  for (uint8_t i = 0; i < n; i++) m.add(pats[i]);
+
+  const char alphabet[] = "abOK\r\nERO";
+  std::string data;
+  srand(1);
+  for (long i = 0; i < 200000; i++) {
+    char c = alphabet[rand() % (sizeof(alphabet) - 1)];
+    data += c;
+    if (data.size() > 16) data.erase(0, 1);
+    uint8_t want = 0;
+    for (uint8_t j = 0; j < n && !want; j++) {
+      size_t l = strlen(pats[j]);
+      if (data.size() >= l && !data.compare(data.size() - l, l, pats[j])) {
+        want = j + 1;
+      }
+    }
+    if (m.feed(c) != want) {
+      printf("matcher: wrong result after %ld characters\n", i + 1);
+      return false;
+    }
+  }
+  printf("matcher: 200000 characters, same matches as endsWith()\n");
+  return true;
+}
+
+int main() {
+  if (!checkMatcher()) return 1;
+
+  HostStream    fs;
+  TinyGsm       modem(fs);
+  TinyGsmClient client(modem, 0);
+
+  const std::string traffic = "\r\n+CSQ: 20,0\r\n\r\nOK\r\n"
+                              "\r\n+CIPRXGET: 1,0\r\n"
+                              "\r\n+CIPRXGET: 4,0,12\r\n\r\nOK\r\n";
+  const int iterations = 20000;
+  size_t    bytes = 0;
+  int       ok    = 0;
+
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    fs.feed(traffic);
+    bytes += traffic.size();
+    ok += modem.waitResponse(GF("+CSQ:")) == 1;
+    ok += modem.waitResponse() == 1;
+    ok += modem.waitResponse(GF("+CIPRXGET:")) == 1;
+    ok += modem.waitResponse() == 1;
+  }
+  double s = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                           t0)
+                 .count();
+
+  printf("waitResponse: %d of %d responses found, %.1f MB/s\n", ok,
+         4 * iterations, bytes / s / 1e6);
+  return ok == 4 * iterations ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file       bench_read.cpp
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * The socket read path: downloads extras/test_100k.bin from a simulated
+ * SIM800 answering +CIPRXGET=2, with read() calls of 1, 64 and 512 bytes,
+ * and reports the calls to the stream's available(), the AT commands sent
+ * and whether the data came through intact.  Each byte used to cost at least
+ * one available() call.
+ *
+ * Build and run from this directory:
+ *   g++ -std=c++11 -O2 -Ihost -I../../src bench_read.cpp host/host.cpp \
+ *       -o bench_read && ./bench_read
+ *
+ * The file to download may be given as the first argument.
+ */
+
+#define TINY_GSM_MODEM_SIM800
+
+#include "ModemSim.h"
+
+#include <TinyGsmClient.h>
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+static bool download(const std::string& file, size_t chunk) {
+  ModemSim      sim;
+  TinyGsm       modem(sim);
+  TinyGsmClient client(modem, 0);
+  sim.file = file;
+  if (!client.connect("example.com", 80)) {
+    printf("read %4zu: connect failed\n", chunk);
+    return false;
+  }
+  sim.availableCalls = 0;
+  sim.cmds           = 0;
+
+  std::string          got;
+  std::vector<uint8_t> buf(chunk);
+  std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+  for (int idle = 0; got.size() < file.size() && idle < 100;) {
+    int n = client.read(buf.data(), chunk);
+    if (n <= 0) {
+      idle++;
+      continue;
+    }
+    idle = 0;
+    got.append(reinterpret_cast<const char*>(buf.data()), n);
+  }
+  double ms = std::chrono::duration<double, std::milli>(
+                  std::chrono::steady_clock::now() - t0)
+                  .count();
+
+  bool ok = got == file;
+  printf("read %4zu: %7zu available() calls, %4zu AT commands, %6.1f ms, %s\n",
+         chunk, sim.availableCalls, sim.cmds, ms, ok ? "intact" : "CORRUPT");
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  host_fake_time = true;
+  std::ifstream f(argc > 1 ? argv[1] : "../../extras/test_100k.bin",
+                  std::ios::binary);
+  std::string   file((std::istreambuf_iterator<char>(f)),
+                   std::istreambuf_iterator<char>());
+  if (file.empty()) {
+    printf("Can't read the test file\n");
+    return 1;
+  }
+  printf("%zu bytes\n", file.size());
+  bool ok = true;
+  ok &= download(file, 1);
+  ok &= download(file, 64);
+  ok &= download(file, 512);
+  return ok ? 0 : 1;
+}
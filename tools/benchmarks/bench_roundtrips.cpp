@@ -0,0 +1,88 @@
+/**
+ * @file       bench_roundtrips.cpp
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * The AT traffic of a download: fetches extras/test_100k.bin from a scripted
+ * modem, once a byte at a time with available()/read() and once with
+ * read(buf, 512), and reports the AT round trips per kB and the commands
+ * behind them.  Each reply has to be waited for, so on a real link these
+ * round trips, not the copying, bound the download rate.
+ *
+ * The modem is picked at build time; build and run from this directory:
+ *   g++ -std=c++11 -O2 -Ihost -I../../src -DTINY_GSM_MODEM_BG96 \
+ *       bench_roundtrips.cpp host/host.cpp -o bench_roundtrips &&
+ *       ./bench_roundtrips
+ *
+ * host/ModemSim.h lists the modems it can play; SIM800 is the default.
+ */
+
+#if !defined TINY_GSM_MODEM_SIM800 && !defined TINY_GSM_MODEM_BG96 &&  \
+    !defined TINY_GSM_MODEM_SIM7080 && !defined TINY_GSM_MODEM_SARAR4 && \
+    !defined TINY_GSM_MODEM_SEQUANS_MONARCH && !defined TINY_GSM_MODEM_UBLOX
+#define TINY_GSM_MODEM_SIM800
+#endif
+#define TINY_GSM_RX_BUFFER 1024
+
+#include "ModemSim.h"
+
+#include <TinyGsmClient.h>
+
+#include <fstream>
+#include <iterator>
+
+static bool download(const std::string& file, size_t chunk) {
+  ModemSim      sim;
+  TinyGsm       modem(sim);
+  TinyGsmClient client(modem, 0);
+  sim.file = file;
+  if (!client.connect("example.com", 80)) {
+    printf("connect failed\n");
+    return false;
+  }
+  sim.cmds = 0;
+  sim.counts.clear();
+
+  std::string got;
+  uint8_t     buf[512];
+  for (int idle = 0; got.size() < file.size() && idle < 100;) {
+    int n = 0;
+    if (chunk == 1) {
+      if (client.available()) buf[n++] = client.read();
+    } else {
+      n = client.read(buf, chunk);
+    }
+    if (n <= 0) {
+      idle++;
+      continue;
+    }
+    idle = 0;
+    got.append(reinterpret_cast<const char*>(buf), n);
+  }
+
+  bool ok = got == file;
+  printf("%-16s %5.2f AT/kB%s ", chunk == 1 ? "byte reads" : "read(buf, 512)",
+         sim.cmds / (file.size() / 1024.0), ok ? "" : " CORRUPT");
+  for (std::map<std::string, int>::const_iterator i = sim.counts.begin();
+       i != sim.counts.end(); ++i) {
+    printf(" %s:%d", i->first.c_str(), i->second);
+  }
+  printf("\n");
+  return ok;
+}
+
+int main(int argc, char** argv) {
+  host_fake_time = true;
+  std::ifstream f(argc > 1 ? argv[1] : "../../extras/test_100k.bin",
+                  std::ios::binary);
+  std::string   file((std::istreambuf_iterator<char>(f)),
+                   std::istreambuf_iterator<char>());
+  if (file.empty()) {
+    printf("Can't read the test file\n");
+    return 1;
+  }
+  bool ok = true;
+  ok &= download(file, 1);
+  ok &= download(file, 512);
+  return ok ? 0 : 1;
+}
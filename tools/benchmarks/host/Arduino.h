@@ -0,0 +1,458 @@
+/**
+ * @file       Arduino.h
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * Just enough of the Arduino core to build TinyGSM on a PC for the
+ * benchmarks in tools/benchmarks.  Nothing here talks to hardware.
+ *
+ * millis() runs on the wall clock, unless host_fake_time is set, in which
+ * case it only moves when delay() or a timed stream read moves it.  That
+ * keeps the time-outs and poll intervals of a benchmark repeatable.
+ */
+
+#ifndef HOST_ARDUINO_H_
+#define HOST_ARDUINO_H_
+
+#include <ctype.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <thread>
+
+typedef bool    boolean;
+typedef uint8_t byte;
+
+#define PROGMEM
+#define F(x) (x)
+class __FlashStringHelper;
+
+#define HEX 16
+#define DEC 10
+#define OUTPUT 1
+#define HIGH 1
+#define LOW 0
+
+extern uint32_t host_millis;     /// The simulated clock
+extern bool     host_fake_time;  /// Whether millis() reads host_millis
+
+inline uint32_t millis() {
+  if (host_fake_time) return host_millis;
+  using namespace std::chrono;
+  static steady_clock::time_point t0 = steady_clock::now();
+  return duration_cast<milliseconds>(steady_clock::now() - t0).count();
+}
+inline void delay(uint32_t ms) {
+  if (host_fake_time) {
+    host_millis += ms ? ms : 1;
+  } else if (ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+  }
+}
+inline void yield() {}
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+
+inline bool isDigit(int c) {
+  return isdigit(c);
+}
+inline bool isHexadecimalDigit(int c) {
+  return isxdigit(c);
+}
+inline bool isAlpha(int c) {
+  return isalpha(c);
+}
+template <class T, class L, class H>
+T constrain(T x, L l, H h) {
+  return x < l ? l : (x > h ? h : x);
+}
+inline long map(long x, long a, long b, long c, long d) {
+  return (x - a) * (d - c) / (b - a) + c;
+}
+
+class String {
+ public:
+  String() {}
+  String(const char* c) : s(c ? c : "") {}  // NOLINT
+  String(const std::string& c) : s(c) {}    // NOLINT
+  String(char c) : s(1, c) {}               // NOLINT
+  explicit String(int v, int base = DEC) : s(fmt(v, base)) {}
+  explicit String(unsigned v, int base = DEC) : s(fmt(v, base)) {}
+  explicit String(long v, int base = DEC) : s(fmt(v, base)) {}
+  explicit String(unsigned long v, int base = DEC) : s(fmt(v, base)) {}
+  explicit String(unsigned char v, int base = DEC) : s(fmt(v, base)) {}
+  explicit String(double v, int d = 2) {
+    char b[64];
+    snprintf(b, sizeof(b), "%.*f", d, v);
+    s = b;
+  }
+
+  void reserve(size_t n) {
+    s.reserve(n);
+  }
+  size_t length() const {
+    return s.size();
+  }
+  const char* c_str() const {
+    return s.c_str();
+  }
+  char operator[](unsigned i) const {
+    return i < s.size() ? s[i] : 0;
+  }
+  char& operator[](unsigned i) {
+    return s[i];
+  }
+  char charAt(unsigned i) const {
+    return (*this)[i];
+  }
+  bool operator==(const String& o) const {
+    return s == o.s;
+  }
+  bool operator!=(const String& o) const {
+    return s != o.s;
+  }
+
+  String& operator+=(const String& o) {
+    s += o.s;
+    return *this;
+  }
+  String& operator+=(const char* o) {
+    s += o;
+    return *this;
+  }
+  String& operator+=(char c) {
+    s += c;
+    return *this;
+  }
+  String& operator+=(unsigned char v) {
+    return *this += String(v);
+  }
+  String& operator+=(int v) {
+    return *this += String(v);
+  }
+  String& operator+=(unsigned v) {
+    return *this += String(v);
+  }
+  String& operator+=(long v) {
+    return *this += String(v);
+  }
+  String& operator+=(unsigned long v) {
+    return *this += String(v);
+  }
+  String& operator+=(double v) {
+    return *this += String(v);
+  }
+
+  bool startsWith(const String& o, unsigned off = 0) const {
+    return off <= s.size() && s.compare(off, o.s.size(), o.s) == 0;
+  }
+  bool endsWith(const String& o) const {
+    return s.size() >= o.s.size() &&
+        s.compare(s.size() - o.s.size(), o.s.size(), o.s) == 0;
+  }
+  int indexOf(const String& c, unsigned from = 0) const {
+    return pos(s.find(c.s, from));
+  }
+  int indexOf(char c, unsigned from = 0) const {
+    return pos(s.find(c, from));
+  }
+  int lastIndexOf(const String& c) const {
+    return pos(s.rfind(c.s));
+  }
+  int lastIndexOf(const String& c, unsigned from) const {
+    return pos(s.rfind(c.s, from));
+  }
+  int lastIndexOf(char c) const {
+    return pos(s.rfind(c));
+  }
+  int lastIndexOf(char c, unsigned from) const {
+    return pos(s.rfind(c, from));
+  }
+  String substring(unsigned a) const {
+    return a >= s.size() ? String() : String(s.substr(a));
+  }
+  String substring(unsigned a, unsigned b) const {
+    if (a > b) std::swap(a, b);
+    return a >= s.size() ? String() : String(s.substr(a, b - a));
+  }
+
+  void trim() {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    size_t b = s.find_last_not_of(" \t\r\n");
+    s        = a == std::string::npos ? "" : s.substr(a, b - a + 1);
+  }
+  void replace(const String& f, const String& r) {
+    if (f.s.empty()) return;
+    for (size_t p = 0; (p = s.find(f.s, p)) != std::string::npos;
+         p += r.s.size()) {
+      s.replace(p, f.s.size(), r.s);
+    }
+  }
+  void replace(char f, char r) {
+    std::replace(s.begin(), s.end(), f, r);
+  }
+  void remove(unsigned i) {
+    if (i < s.size()) s.erase(i);
+  }
+  void remove(unsigned i, unsigned n) {
+    if (i < s.size()) s.erase(i, n);
+  }
+  void toUpperCase() {
+    for (size_t i = 0; i < s.size(); i++) s[i] = toupper(s[i]);
+  }
+  void toLowerCase() {
+    for (size_t i = 0; i < s.size(); i++) s[i] = tolower(s[i]);
+  }
+  void toCharArray(char* b, unsigned n) const {
+    if (!n) return;
+    strncpy(b, s.c_str(), n - 1);
+    b[n - 1] = 0;
+  }
+  long toInt() const {
+    return atol(s.c_str());
+  }
+  float toFloat() const {
+    return atof(s.c_str());
+  }
+
+ private:
+  static std::string fmt(unsigned long v, int base) {
+    char b[34];
+    snprintf(b, sizeof(b), base == HEX ? "%lx" : "%lu", v);
+    return b;
+  }
+  static std::string fmt(long v, int base) {
+    if (base == HEX) return fmt(static_cast<unsigned long>(v), base);
+    char b[34];
+    snprintf(b, sizeof(b), "%ld", v);
+    return b;
+  }
+  static std::string fmt(int v, int base) {
+    return fmt(static_cast<long>(v), base);
+  }
+  static std::string fmt(unsigned v, int base) {
+    return fmt(static_cast<unsigned long>(v), base);
+  }
+  static int pos(size_t p) {
+    return p == std::string::npos ? -1 : static_cast<int>(p);
+  }
+
+  std::string s;
+};
+
+inline String operator+(const String& a, const String& b) {
+  String r(a);
+  return r += b;
+}
+inline String operator+(const String& a, const char* b) {
+  String r(a);
+  return r += b;
+}
+inline String operator+(const String& a, char b) {
+  String r(a);
+  return r += b;
+}
+inline String operator+(const String& a, int b) {
+  String r(a);
+  return r += b;
+}
+
+class Print {
+ public:
+  Print() : write_error(0) {}
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t) = 0;
+  virtual size_t write(const uint8_t* b, size_t n) {
+    size_t r = 0;
+    while (n--) r += write(*b++);
+    return r;
+  }
+  size_t write(const char* str) {
+    return str ? write(str, strlen(str)) : 0;
+  }
+  size_t write(const char* b, size_t n) {
+    return write(reinterpret_cast<const uint8_t*>(b), n);
+  }
+  virtual int availableForWrite() {
+    return 0;
+  }
+  virtual void flush() {}
+
+  int getWriteError() {
+    return write_error;
+  }
+  void clearWriteError() {
+    setWriteError(0);
+  }
+
+  size_t print(const char* s) {
+    return write(s);
+  }
+  size_t print(const String& s) {
+    return write(s.c_str(), s.length());
+  }
+  size_t print(char c) {
+    return write(static_cast<uint8_t>(c));
+  }
+  size_t print(unsigned char v, int b = DEC) {
+    return print(String(v, b));
+  }
+  size_t print(int v, int b = DEC) {
+    return print(String(v, b));
+  }
+  size_t print(unsigned v, int b = DEC) {
+    return print(String(v, b));
+  }
+  size_t print(short v, int b = DEC) {  // NOLINT
+    return print(String(static_cast<int>(v), b));
+  }
+  size_t print(unsigned short v, int b = DEC) {  // NOLINT
+    return print(String(static_cast<unsigned>(v), b));
+  }
+  size_t print(long v, int b = DEC) {
+    return print(String(v, b));
+  }
+  size_t print(unsigned long v, int b = DEC) {
+    return print(String(v, b));
+  }
+  size_t print(double v, int d = 2) {
+    return print(String(v, d));
+  }
+  template <typename T>
+  size_t println(T v) {
+    size_t n = print(v);
+    return n + println();
+  }
+  size_t println() {
+    return print("\r\n");
+  }
+
+ protected:
+  void setWriteError(int err = 1) {
+    write_error = err;
+  }
+
+ private:
+  int write_error;
+};
+
+class Stream : public Print {
+ public:
+  Stream() : _timeout(1000) {}
+
+  virtual int available() = 0;
+  virtual int read()      = 0;
+  virtual int peek()      = 0;
+
+  void setTimeout(unsigned long t) {
+    _timeout = t;
+  }
+
+  size_t readBytes(char* b, size_t n) {
+    size_t i = 0;
+    for (int c; i < n && (c = timedRead()) >= 0;) b[i++] = c;
+    return i;
+  }
+  size_t readBytes(uint8_t* b, size_t n) {
+    return readBytes(reinterpret_cast<char*>(b), n);
+  }
+  size_t readBytesUntil(char t, char* b, size_t n) {
+    size_t i = 0;
+    for (int c; i < n && (c = timedRead()) >= 0 && c != t;) b[i++] = c;
+    return i;
+  }
+  String readStringUntil(char t) {
+    String r;
+    for (int c; (c = timedRead()) >= 0 && c != t;) r += static_cast<char>(c);
+    return r;
+  }
+  String readString() {
+    String r;
+    for (int c; (c = timedRead()) >= 0;) r += static_cast<char>(c);
+    return r;
+  }
+  long parseInt() {
+    int c;
+    while ((c = timedPeek()) >= 0 && c != '-' && !isdigit(c)) read();
+    bool neg = c == '-';
+    if (neg) read();
+    long v = 0;
+    while ((c = timedPeek()) >= 0 && isdigit(c)) {
+      v = v * 10 + c - '0';
+      read();
+    }
+    return neg ? -v : v;
+  }
+  float parseFloat() {
+    int c;
+    while ((c = timedPeek()) >= 0 && c != '-' && c != '.' && !isdigit(c)) {
+      read();
+    }
+    String r;
+    while ((c = timedPeek()) >= 0 && (c == '-' || c == '.' || isdigit(c))) {
+      r += static_cast<char>(c);
+      read();
+    }
+    return r.toFloat();
+  }
+  bool find(const char* t) {
+    size_t m = 0, n = strlen(t);
+    for (int c; (c = timedRead()) >= 0;) {
+      m = c == t[m] ? m + 1 : 0;
+      if (m == n) return true;
+    }
+    return false;
+  }
+
+ protected:
+  int timedRead() {
+    uint32_t start = millis();
+    do {
+      int c = read();
+      if (c >= 0) return c;
+      if (host_fake_time) host_millis++;
+    } while (millis() - start < _timeout);
+    return -1;
+  }
+  int timedPeek() {
+    uint32_t start = millis();
+    do {
+      int c = peek();
+      if (c >= 0) return c;
+      if (host_fake_time) host_millis++;
+    } while (millis() - start < _timeout);
+    return -1;
+  }
+
+  unsigned long _timeout;
+};
+
+class HardwareSerial : public Stream {
+ public:
+  void begin(uint32_t) {}
+  int available() override {
+    return 0;
+  }
+  int read() override {
+    return -1;
+  }
+  int peek() override {
+    return -1;
+  }
+  size_t write(uint8_t) override {
+    return 1;
+  }
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif  // HOST_ARDUINO_H_
@@ -0,0 +1,55 @@
+/**
+ * @file       HostStream.h
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * A Stream standing in for the modem's serial port: bytes queued with feed()
+ * are read back by the library, and whatever the library writes is kept in
+ * out.  writes counts the calls to write(), as each would be a UART driver
+ * call on a board.
+ */
+
+#ifndef HOST_HOSTSTREAM_H_
+#define HOST_HOSTSTREAM_H_
+
+#include "Arduino.h"
+
+class HostStream : public Stream {
+ public:
+  HostStream() : pos(0), writes(0) {}
+
+  int available() override {
+    return static_cast<int>(in.size() - pos);
+  }
+  int read() override {
+    return pos < in.size() ? static_cast<uint8_t>(in[pos++]) : -1;
+  }
+  int peek() override {
+    return pos < in.size() ? static_cast<uint8_t>(in[pos]) : -1;
+  }
+  size_t write(uint8_t c) override {
+    writes++;
+    out += static_cast<char>(c);
+    return 1;
+  }
+  size_t write(const uint8_t* b, size_t n) override {
+    writes++;
+    out.append(reinterpret_cast<const char*>(b), n);
+    return n;
+  }
+  using Print::write;
+
+  // Queue bytes for the library to read, dropping what it already has
+  void feed(const std::string& s) {
+    in.erase(0, pos);
+    pos = 0;
+    in += s;
+  }
+
+  std::string in;      /// The bytes "sent by the modem"
+  size_t      pos;     /// How far the library has read them
+  std::string out;     /// The bytes the library wrote
+  size_t      writes;  /// The number of write() calls
+};
+
+#endif  // HOST_HOSTSTREAM_H_
@@ -0,0 +1,36 @@
+/**
+ * @file       IPAddress.h
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * The Arduino IPAddress class, for the host build of the benchmarks.
+ */
+
+#ifndef HOST_IPADDRESS_H_
+#define HOST_IPADDRESS_H_
+
+#include "Arduino.h"
+
+class IPAddress {
+ public:
+  IPAddress() : a{0, 0, 0, 0} {}
+  IPAddress(uint8_t x, uint8_t y, uint8_t z, uint8_t w) : a{x, y, z, w} {}
+
+  uint8_t operator[](int i) const {
+    return a[i];
+  }
+  uint8_t& operator[](int i) {
+    return a[i];
+  }
+  bool operator==(const IPAddress& o) const {
+    return !memcmp(a, o.a, sizeof(a));
+  }
+  bool operator!=(const IPAddress& o) const {
+    return !(*this == o);
+  }
+
+ private:
+  uint8_t a[4];
+};
+
+#endif  // HOST_IPADDRESS_H_
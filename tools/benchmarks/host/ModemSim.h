@@ -0,0 +1,192 @@
+/**
+ * @file       ModemSim.h
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * A Stream that plays the modem picked with TINY_GSM_MODEM_*, answering the
+ * AT commands the library sends.  SIM800, BG96, SIM7080, Sequans Monarch,
+ * SARA-R4 and u-blox are scripted.  Socket 0 serves the bytes in file, and
+ * the modem reports at most 8000 of them waiting at a time, as a real one
+ * would; any command it doesn't know gets a plain OK.
+ *
+ * cmds counts the commands received and counts[] breaks them down by name,
+ * with "(read)" or "(query)" added for reads that fetch data and reads that
+ * only ask how much is waiting.  availableCalls counts the library's calls to
+ * available(), since each costs at least a function call on a board.
+ */
+
+#ifndef HOST_MODEMSIM_H_
+#define HOST_MODEMSIM_H_
+
+#include "Arduino.h"
+
+#include <map>
+
+class ModemSim : public Stream {
+ public:
+  ModemSim() : fpos(0), cmds(0), availableCalls(0), pos(0) {}
+
+  int available() override {
+    availableCalls++;
+    return static_cast<int>(in.size() - pos);
+  }
+  int read() override {
+    return pos < in.size() ? static_cast<uint8_t>(in[pos++]) : -1;
+  }
+  int peek() override {
+    return pos < in.size() ? static_cast<uint8_t>(in[pos]) : -1;
+  }
+  size_t write(uint8_t c) override {
+    onChar(c);
+    return 1;
+  }
+  size_t write(const uint8_t* b, size_t n) override {
+    for (size_t i = 0; i < n; i++) onChar(b[i]);
+    return n;
+  }
+  using Print::write;
+
+  // Queue unsolicited output from the modem
+  void urc(const std::string& s) {
+    in.erase(0, pos);
+    pos = 0;
+    in += s;
+  }
+
+  std::string                file;            /// The data socket 0 serves
+  size_t                     fpos;            /// How much of it was served
+  size_t                     cmds;            /// AT commands received
+  size_t                     availableCalls;  /// Calls to available()
+  std::map<std::string, int> counts;          /// Commands by name
+
+ private:
+  // The modem only has so much buffered at a time
+  size_t left() const {
+    return std::min<size_t>(file.size() - fpos, 8000);
+  }
+  std::string take(int want) {
+    size_t      k = std::min(static_cast<size_t>(want), left());
+    std::string d = file.substr(fpos, k);
+    fpos += k;
+    return d;
+  }
+  static std::string num(size_t n) {
+    return String(static_cast<unsigned long>(n)).c_str();
+  }
+
+  void onChar(uint8_t c) {
+    if (c == '\n') return;
+    if (c != '\r') {
+      cmd += static_cast<char>(c);
+      return;
+    }
+    cmds++;
+    std::string key = cmd.substr(0, cmd.find_first_of("=?"));
+    std::string o   = answer(key);
+    counts[key]++;
+    urc(o.empty() ? "\r\nOK\r\n" : o);
+    cmd.clear();
+  }
+
+  // The reply to cmd, or "" for a plain OK; may add to key
+  std::string answer(std::string& key) {
+    int want;
+#if defined TINY_GSM_MODEM_SIM800
+    if (cmd.compare(0, 12, "AT+CIPSTART=") == 0) {
+      return std::string("\r\nOK\r\n\r\n0, CONNECT OK\r\n") +
+          (left() ? "\r\n+CIPRXGET: 1,0\r\n" : "");
+    }
+    if (sscanf(cmd.c_str(), "AT+CIPRXGET=2,0,%d", &want) == 1) {
+      key += "(read)";
+      std::string d = take(want);
+      return "\r\n+CIPRXGET: 2,0," + num(d.size()) + "," + num(left()) +
+          "\r\n" + d + "\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+CIPRXGET=4,0") {
+      key += "(query)";
+      return "\r\n+CIPRXGET: 4,0," + num(left()) + "\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+CIPSTATUS=0") {
+      return "\r\n+CIPSTATUS: 0,0,\"TCP\",\"1.2.3.4\",\"80\",\"CONNECTED\""
+             "\r\n\r\nOK\r\n";
+    }
+#elif defined TINY_GSM_MODEM_BG96
+    if (cmd.compare(0, 10, "AT+QIOPEN=") == 0) {
+      return std::string("\r\nOK\r\n\r\n+QIOPEN: 0,0\r\n") +
+          (left() ? "\r\n+QIURC: \"recv\",0\r\n" : "");
+    }
+    if (sscanf(cmd.c_str(), "AT+QIRD=0,%d", &want) == 1 && want) {
+      key += "(read)";
+      std::string d = take(want);
+      return "\r\n+QIRD: " + num(d.size()) + "\r\n" + d + "\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+QIRD=0,0") {
+      key += "(query)";
+      return "\r\n+QIRD: 0,0," + num(left()) + "\r\n\r\nOK\r\n";
+    }
+    if (cmd.compare(0, 10, "AT+QISTATE") == 0) {
+      return "\r\n+QISTATE: 0,\"TCP\",\"1.2.3.4\",80,5087,2,1,0,0,\"uart1\""
+             "\r\n\r\nOK\r\n";
+    }
+#elif defined TINY_GSM_MODEM_SIM7080
+    if (cmd.compare(0, 10, "AT+CAOPEN=") == 0) {
+      return std::string("\r\n+CAOPEN: 0,0\r\n\r\nOK\r\n") +
+          (left() ? "\r\n+CADATAIND: 0\r\n" : "");
+    }
+    if (sscanf(cmd.c_str(), "AT+CARECV=0,%d", &want) == 1) {
+      key += "(read)";
+      std::string d = take(want);
+      return "\r\n+CARECV: " + num(d.size()) + "," + d + "\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+CARECV?") {
+      key += "(query)";
+      return left() ? "\r\n+CARECV: 0," + num(left()) + "\r\n\r\nOK\r\n"
+                    : "";
+    }
+    if (cmd == "AT+CASTATE?") return "\r\n+CASTATE: 0,1\r\n\r\nOK\r\n";
+#elif defined TINY_GSM_MODEM_SEQUANS_MONARCH
+    if (cmd.compare(0, 9, "AT+SQNSD=") == 0) {
+      return std::string("\r\nOK\r\n") +
+          (left() ? "\r\n+SQNSRING: 1," + num(left()) + "\r\n" : "");
+    }
+    if (sscanf(cmd.c_str(), "AT+SQNSRECV=1,%d", &want) == 1) {
+      key += "(read)";
+      std::string d = take(want);
+      return "\r\n+SQNSRECV: 1," + num(d.size()) + "\r\n" + d +
+          "\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+SQNSI=1") {
+      key += "(query)";
+      return "\r\n+SQNSI: 1,0,0," + num(left()) + ",0\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+SQNSS") return "\r\n+SQNSS: 1,2,1.2.3.4,80\r\n\r\nOK\r\n";
+#elif defined TINY_GSM_MODEM_SARAR4 || defined TINY_GSM_MODEM_UBLOX
+    if (cmd == "AT+USOCR=6") return "\r\n+USOCR: 0\r\n\r\nOK\r\n";
+    if (cmd.compare(0, 9, "AT+USOCO=") == 0) {
+      return std::string("\r\nOK\r\n") +
+          (left() ? "\r\n+UUSORD: 0," + num(left()) + "\r\n" : "");
+    }
+    if (sscanf(cmd.c_str(), "AT+USORD=0,%d", &want) == 1 && want) {
+      key += "(read)";
+      std::string d = take(want);
+      return "\r\n+USORD: 0," + num(d.size()) + ",\"" + d +
+          "\"\r\n\r\nOK\r\n";
+    }
+    if (cmd == "AT+USORD=0,0") {
+      key += "(query)";
+      return "\r\n+USORD: 0," + num(left()) + "\r\n\r\nOK\r\n";
+    }
+    if (cmd.compare(0, 10, "AT+USOCTL=") == 0) {
+      return "\r\n+USOCTL: 0,10,4\r\n\r\nOK\r\n";
+    }
+#endif
+    (void)want;
+    return "";
+  }
+
+  std::string cmd;  /// The command being received
+  std::string in;   /// The modem's output not yet read
+  size_t      pos;  /// How far the library has read it
+};
+
+#endif  // HOST_MODEMSIM_H_
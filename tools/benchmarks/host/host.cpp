@@ -0,0 +1,13 @@
+/**
+ * @file       host.cpp
+ * @license    LGPL-3.0
+ * @date       Oct 2026
+ *
+ * The globals of the host Arduino core, linked into every benchmark.
+ */
+
+#include "Arduino.h"
+
+uint32_t       host_millis    = 0;
+bool           host_fake_time = false;
+HardwareSerial Serial;